@@ -2,16 +2,33 @@
 #include <fstream>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
 static inline int popcount32(unsigned int x){ return __builtin_popcount(x); }
-bool Forest::load(const std::string& path){ std::ifstream in(path); if(!in) return false; trees.clear(); std::string tag; int T=0; in>>tag>>T; for(int t=0;t<T;++t){ std::string tt; int N; in>>tt>>N; Tree tr; tr.n.resize(N); for(int i=0;i<N;++i){ int idx, f, l, r; double th, p0, p1, p2; in>>idx>>f>>th>>l>>r>>p0>>p1>>p2; tr.n[i].f=f; tr.n[i].t=th; tr.n[i].l=l; tr.n[i].r=r; tr.n[i].leaf = (l<0 && r<0); tr.n[i].p[0]=p0; tr.n[i].p[1]=p1; tr.n[i].p[2]=p2; } trees.push_back(tr);} return true; }
-std::vector<double> Forest::proba(const std::vector<double>& x) const{ double a0=0,a1=0,a2=0; for(auto& t:trees){ int i=0; while(!t.n[i].leaf){ const auto& nd=t.n[i]; i = (x[nd.f] <= nd.t) ? nd.l : nd.r; } a0+=t.n[i].p[0]; a1+=t.n[i].p[1]; a2+=t.n[i].p[2]; } double Z = a0+a1+a2; if(Z<=0) return {0.34,0.33,0.33}; return {a0/Z,a1/Z,a2/Z}; }
-bool Calibrator::load(const std::string& path){ std::ifstream in(path); if(!in) return false; std::string k; double v; while(in>>k>>v){ if(k=="w_pcyber") w_p=v; else if(k=="w_rule") w_r=v; else if(k=="w_novelty") w_n=v; else if(k=="bias") b=v; } return true; }
+bool Forest::load(const std::string& path){ std::ifstream in(path); if(!in) return false; trees.clear(); std::string tag; int T=0; in>>tag>>T; for(int t=0;t<T;++t){ std::string tt; int N; in>>tt>>N; Tree tr; tr.n.resize(N); for(int i=0;i<N;++i){ int idx, f, l, r; double th, p0, p1, p2; in>>idx>>f>>th>>l>>r>>p0>>p1>>p2; tr.n[i].f=f; tr.n[i].t=th; tr.n[i].l=l; tr.n[i].r=r; tr.n[i].leaf = (l<0 && r<0); tr.n[i].parent=-1; tr.n[i].p[0]=p0; tr.n[i].p[1]=p1; tr.n[i].p[2]=p2; } linkParents(tr.n); trees.push_back(tr);} return true; }
+// Parent links for leaf-to-root walks. Older exports leave internal nodes at the 0.34/0.33/0.33 placeholder;
+// those get the unweighted mean of their children (sklearn numbers children after parents, so one reverse pass suffices).
+void Forest::linkParents(std::vector<Node>& n){ const int N=static_cast<int>(n.size()); for(int i=0;i<N;++i){ if(n[i].leaf) continue; if(n[i].l>=0 && n[i].l<N) n[n[i].l].parent=i; if(n[i].r>=0 && n[i].r<N) n[n[i].r].parent=i; } for(int i=N-1;i>=0;--i){ Node& nd=n[i]; const bool placeholder = std::fabs(nd.p[0]-0.34)<1e-9 && std::fabs(nd.p[1]-0.33)<1e-9 && std::fabs(nd.p[2]-0.33)<1e-9; if(nd.leaf || !placeholder || nd.l<=i || nd.r<=i || nd.l>=N || nd.r>=N) continue; for(int c=0;c<3;++c) nd.p[c] = 0.5*(n[nd.l].p[c] + n[nd.r].p[c]); } }
+std::vector<double> Forest::proba(const std::vector<double>& x, int* leaves) const{ double a0=0,a1=0,a2=0; for(auto& t:trees){ int i=0; while(!t.n[i].leaf){ const auto& nd=t.n[i]; i = (x[nd.f] <= nd.t) ? nd.l : nd.r; } if(leaves) *leaves++ = i; a0+=t.n[i].p[0]; a1+=t.n[i].p[1]; a2+=t.n[i].p[2]; } double Z = a0+a1+a2; if(Z<=0) return {0.34,0.33,0.33}; return {a0/Z,a1/Z,a2/Z}; }
+std::size_t Forest::maxNodes() const{ std::size_t m=0; for(auto& t:trees) m = std::max(m, t.n.size()); return m; }
+// Saabas attribution: walking each recorded leaf back to its root, every split credits its feature with the
+// change in class-cls probability it caused. Shares plus the returned root mean sum to proba()[cls].
+double Forest::explain(const int* leaves, int cls, double* contrib, std::size_t nf) const{ double Z=0, bias=0; for(std::size_t t=0;t<trees.size();++t){ const auto& n=trees[t].n; const Node& lf=n[leaves[t]]; Z += lf.p[0]+lf.p[1]+lf.p[2]; } if(Z<=0) return 0.0; const double inv=1.0/Z; for(std::size_t t=0;t<trees.size();++t){ const auto& n=trees[t].n; int i=leaves[t]; while(n[i].parent>=0){ const Node& up=n[n[i].parent]; if(up.f>=0 && static_cast<std::size_t>(up.f)<nf) contrib[up.f] += (n[i].p[cls]-up.p[cls])*inv; i=n[i].parent; } bias += n[i].p[cls]*inv; } return bias; }
+bool Calibrator::load(const std::string& path){ std::ifstream in(path); if(!in) return false; std::string line, k; double v; while(std::getline(in,line)){ std::istringstream ls(line); if(!(ls>>k>>v)) continue; if(k=="w_pcyber") w_p=v; else if(k=="w_rule") w_r=v; else if(k=="w_novelty") w_n=v; else if(k=="bias") b=v; } return true; }
 double Calibrator::sig(double z){ return 1.0/(1.0+std::exp(-z)); }
 double Calibrator::score(double pcyber, double rules, double nov) const{ return sig(w_p*pcyber + w_r*rules + w_n*nov + b); }
 void RuleGuard::load(const std::string&){}
 double RuleGuard::rulescore(unsigned int guard_bits) const{ int h = popcount32(guard_bits); return h>0 ? std::min(1.0, h/4.0) : 0.0; }
 std::string RuleGuard::reason(unsigned int guard_bits) const{ if(guard_bits==0) return "no-rule-hit"; std::ostringstream s; s<<"rules:"; if(guard_bits&1) s<<"param "; if(guard_bits&2) s<<"rate "; if(guard_bits&4) s<<"replay "; if(guard_bits&8) s<<"mode "; return s.str(); }
-DetectorComponentAi::DetectorComponentAi(){ forest.load("config/forest.model"); calib.load("config/calibrator.cfg"); }
-void DetectorComponentAi::ingest(const FeatureFrame& f){ auto p = forest.proba(f.x); double pcyber = p[1]; double nov = (std::max({p[0],p[1],p[2]})<0.5) ? 1.0 : 0.0; double rs = rules.rulescore(f.guard_bits); last_risk = calib.score(pcyber, rs, nov); std::ostringstream s; int best = (p[1]>p[0] && p[1]>p[2])?1:((p[2]>p[0] && p[2]>p[1])?2:0); s<<"pcyber="<<pcyber<<" class="<<best<<" "<<rules.reason(f.guard_bits)<<" nov="<<(nov>0.5?"y":"n"); last_reason = s.str(); }
+DetectorComponentAi::DetectorComponentAi(){ forest.load("config/forest.model"); calib.load("config/calibrator.cfg"); keyed.load("config/calibrator.cfg"); last_leaves.assign(forest.size(), 0); }
+void DetectorComponentAi::ingest(const FeatureFrame& f){ auto p = forest.proba(f.x, last_leaves.data()); double pcyber = p[1]; last_nov_stream = novelty.update(f.link, f.x); double nov = std::max(NoveltyScorer::forestTerm(std::max({p[0],p[1],p[2]})), last_nov_stream); last_nov = nov; double rs = rules.rulescore(f.guard_bits); last_risk = calib.score(pcyber, rs, nov); last_keyed = f.link < NoveltyScorer::kMaxLinks ? keyed.update(KeyedRiskStore::keyOf(f.link, f.x), f.ts, last_risk) : KeyedRiskStore::Result{}; std::ostringstream s; int best = (p[1]>p[0] && p[1]>p[2])?1:((p[2]>p[0] && p[2]>p[1])?2:0); last_class = best; s<<"pcyber="<<pcyber<<" class="<<best<<" "<<rules.reason(f.guard_bits)<<" nov="<<nov; last_reason = s.str(); }
 double DetectorComponentAi::lastRisk() const{ return last_risk; }
+double DetectorComponentAi::lastNovelty() const{ return last_nov; }
+double DetectorComponentAi::lastStreamNovelty() const{ return last_nov_stream; }
+int DetectorComponentAi::lastClass() const{ return last_class; }
 std::string DetectorComponentAi::lastReason() const{ return last_reason; }
+void DetectorComponentAi::drift(NoveltyScorer::FeatureArray& out) const{ novelty.drift(out); }
+const KeyedRiskStore::Result& DetectorComponentAi::lastKeyed() const{ return last_keyed; }
+std::size_t DetectorComponentAi::hotKeys(KeyedRiskStore::Hot* out, std::size_t n, double now) const{ return keyed.top(out, n, now); }
+std::uint32_t DetectorComponentAi::keyedEvictions() const{ return keyed.evictions(); }
+const Forest& DetectorComponentAi::model() const{ return forest; }
+const std::vector<int>& DetectorComponentAi::lastLeaves() const{ return last_leaves; }
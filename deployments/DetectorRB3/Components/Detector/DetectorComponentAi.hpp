@@ -1,10 +1,13 @@
 #pragma once
 #include <vector>
 #include <string>
-struct FeatureFrame { double ts; std::vector<double> x; unsigned int guard_bits; };
+#include "ModelFeatures.hpp"
+#include "NoveltyScorer.hpp"
+#include "KeyedRiskStore.hpp"
+struct FeatureFrame { double ts; std::vector<double> x; unsigned int guard_bits; unsigned int link=0; };
 class Forest {
-public: bool load(const std::string& path); std::vector<double> proba(const std::vector<double>& x) const;
-private: struct Node{int f; double t; int l; int r; bool leaf; double p[3];}; struct Tree{std::vector<Node> n;}; std::vector<Tree> trees;
+public: bool load(const std::string& path); std::vector<double> proba(const std::vector<double>& x, int* leaves = nullptr) const; std::size_t size() const { return trees.size(); } std::size_t maxNodes() const; double explain(const int* leaves, int cls, double* contrib, std::size_t nf) const;
+private: struct Node{int f; double t; int l; int r; int parent; bool leaf; double p[3];}; struct Tree{std::vector<Node> n;}; std::vector<Tree> trees; static void linkParents(std::vector<Node>& n);
 };
 class Calibrator {
 public: bool load(const std::string& path); double score(double pcyber, double rules, double nov) const;
@@ -14,6 +17,6 @@ class RuleGuard {
 public: void load(const std::string& allowlist_path); double rulescore(unsigned int guard_bits) const; std::string reason(unsigned int guard_bits) const;
 };
 class DetectorComponentAi {
-public: DetectorComponentAi(); void ingest(const FeatureFrame& f); double lastRisk() const; std::string lastReason() const;
-private: Forest forest; Calibrator calib; RuleGuard rules; double last_risk=0.0; std::string last_reason;
+public: DetectorComponentAi(); void ingest(const FeatureFrame& f); double lastRisk() const; double lastNovelty() const; double lastStreamNovelty() const; int lastClass() const; std::string lastReason() const; void drift(NoveltyScorer::FeatureArray& out) const; const KeyedRiskStore::Result& lastKeyed() const; std::size_t hotKeys(KeyedRiskStore::Hot* out, std::size_t n, double now) const; std::uint32_t keyedEvictions() const; const Forest& model() const; const std::vector<int>& lastLeaves() const;
+private: Forest forest; Calibrator calib; RuleGuard rules; NoveltyScorer novelty; KeyedRiskStore keyed; KeyedRiskStore::Result last_keyed{}; double last_risk=0.0, last_nov=0.0, last_nov_stream=0.0; int last_class=0; std::vector<int> last_leaves; std::string last_reason;
 };
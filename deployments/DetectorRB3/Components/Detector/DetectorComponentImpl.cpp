@@ -6,33 +6,45 @@
 DetectorComponentImpl::DetectorComponentImpl(const char* compName, const std::string& config_dir)
 : DetectorComponentBase(compName) {
     load_threshold(config_dir);
+    shadow.load(config_dir + "/shadow", tau);
+    explainer.load(ai.model(), config_dir + "/feature_schema.csv");
 }
 
 void DetectorComponentImpl::init(U32 queueDepth, U32 instance){
     ::DetectorRB3::DetectorComponentBase::init(queueDepth, instance);
+    shadow.start();  // no-op without a shadow model set
+    explainer.start();
 }
 
 void DetectorComponentImpl::load_threshold(const std::string& config_dir){
     std::ifstream in(config_dir + "/calibrator.cfg");
     if(!in) return; // default tau
     std::string k; double v;
-    while(in >> k >> v){
+    std::string line;
+    while(std::getline(in, line)){
+        std::istringstream ls(line);
+        if(!(ls >> k >> v)) continue;  // blank or # comment line
         if(k == "threshold" || k == "tau") { tau = v; }
     }
 }
 
+double DetectorComponentImpl::nowSeconds(){
+    const Fw::Time now = this->getTime();
+    return static_cast<double>(now.getSeconds()) + static_cast<double>(now.getUSeconds()) * 1e-6;
+}
+
 void DetectorComponentImpl::ingestBufferForBringup(Fw::Buffer& fwBuffer){
     this->FeatureIn_handler(0, fwBuffer);
 }
 
-void DetectorComponentImpl::FeatureIn_handler(FwIndexType, Fw::Buffer& fwBuffer){
+void DetectorComponentImpl::FeatureIn_handler(FwIndexType portNum, Fw::Buffer& fwBuffer){
     // Expect fixed-order float buffer per feature_schema.csv (excluding ts)
     const U8* data = fwBuffer.getData();
     const FwSizeType sz = fwBuffer.getSize();
     if(data == nullptr || sz < 17*sizeof(float)) return;
     const float* f = reinterpret_cast<const float*>(data);
     const size_t nf = sz / sizeof(float);
-    FeatureFrame fr; fr.ts = 0.0; fr.x.assign(18, 0.0);
+    FeatureFrame fr; fr.ts = nowSeconds(); fr.x.assign(kModelFeatures, 0.0);
     const size_t copyN = nf < 16 ? nf : 16;
     for(size_t i=0;i<copyN;++i){ fr.x[i] = static_cast<double>(f[i]); }
     unsigned int gb = 0;
@@ -40,15 +52,87 @@ void DetectorComponentImpl::FeatureIn_handler(FwIndexType, Fw::Buffer& fwBuffer)
     else if(nf >= 18) gb = static_cast<unsigned int>(f[17]);
     fr.guard_bits = gb;
     fr.x[17] = static_cast<double>(gb);
+    // No link identifier reaches the Detector yet: FeatureIn is a single port and bring-up feeds port 0,
+    // so every frame is link 0. Scorers ignore links beyond NoveltyScorer::kMaxLinks instead of merging them.
+    fr.link = static_cast<unsigned int>(portNum);
 
+    std::lock_guard<std::mutex> lock(mu);
     ai.ingest(fr);
     const double risk = ai.lastRisk();
     const std::string reason = ai.lastReason();
 
     // Write RiskScore telemetry (0x7000) and emit RiskAlert event when risk>tau
     this->tlmWrite_RiskScore(static_cast<F32>(risk));
+    this->tlmWrite_NoveltyScore(static_cast<F32>(ai.lastNovelty()));
     if(risk > tau){
-        Fw::LogStringArg rsn(reason.c_str());
+        // Attribution is deferred to the explainer worker; the alert only carries the id to match it by
+        ++alertSeq;
+        const std::string tagged = reason + " id=" + std::to_string(alertSeq);
+        Fw::LogStringArg rsn(tagged.c_str());
         this->log_WARNING_HI_RiskAlert(static_cast<F32>(risk), rsn);
+        if(explainer.enabled()){ explainer.submit(alertSeq, risk, ai.lastLeaves()); }
+    }
+    // Slow campaigns: evidence accumulated per (link, subsystem, opcode) crossed its threshold
+    const KeyedRiskStore::Result& kr = ai.lastKeyed();
+    if(kr.alert){
+        this->log_WARNING_HI_KeyedRiskAlert(kr.key.link, kr.key.subsystem, kr.key.opcode, kr.evidence);
+    }
+
+    // Hand the parsed frame and active verdict to the shadow worker; never blocks
+    if(shadow.enabled()){
+        ShadowFrame sf;
+        for(size_t i=0;i<sf.x.size();++i){ sf.x[i] = static_cast<float>(fr.x[i]); }
+        sf.guard_bits = gb;
+        sf.nov_stream = static_cast<float>(ai.lastStreamNovelty());
+        sf.active_risk = static_cast<float>(risk);
+        sf.active_class = ai.lastClass();
+        shadow.submit(sf);
+    }
+}
+
+void DetectorComponentImpl::schedIn_handler(FwIndexType, U32){
+    // Drift and rolling risk move on timescales of minutes; one sample per rate group tick is plenty
+    const double now = nowSeconds();
+    NoveltyScorer::FeatureArray drift;
+    KeyedRiskStore::Hot hot[KeyedRiskStore::kTopN];
+    std::size_t nhot = 0;
+    U32 evictions = 0;
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        ai.drift(drift);
+        nhot = ai.hotKeys(hot, KeyedRiskStore::kTopN, now);
+        evictions = ai.keyedEvictions();
+    }
+    static_assert(::DetectorRB3::FeatureVector::SIZE == kModelFeatures, "FeatureDrift must carry one value per model feature");
+    ::DetectorRB3::FeatureVector tlm;
+    for(FwSizeType i=0; i<::DetectorRB3::FeatureVector::SIZE; ++i){ tlm[i] = drift[i]; }
+    this->tlmWrite_FeatureDrift(tlm);
+
+    ::DetectorRB3::HotKeys hotTlm;
+    for(std::size_t i=0; i<nhot; ++i){
+        hotTlm[i] = ::DetectorRB3::HotKey(hot[i].key.link, hot[i].key.subsystem, hot[i].key.opcode,
+                                          hot[i].evidence, hot[i].frames, hot[i].hits);
+    }
+    this->tlmWrite_KeyedHot(hotTlm);
+    this->tlmWrite_KeyedEvictions(evictions);
+
+    if(shadow.enabled()){
+        const ShadowScorer::Stats st = shadow.snapshot();
+        const ::DetectorRB3::ShadowStats stats(st.frames, st.drops, st.shadow_only_alerts, st.active_only_alerts,
+                                               st.agreement, st.delta_mean, st.delta_p95,
+                                               st.latency_mean_us, st.latency_max_us);
+        this->tlmWrite_Shadow(stats);
+    }
+
+    // Publish attributions finished since the last tick
+    PathExplainer::Explanation ex;
+    while(explainer.poll(ex)){
+        std::ostringstream top;
+        for(std::size_t k=0; k<ex.count; ++k){
+            top << (k ? " " : "") << explainer.name(ex.top[k].feature) << (ex.top[k].contrib >= 0.0f ? "=+" : "=") << ex.top[k].contrib;
+        }
+        Fw::LogStringArg topArg(top.str().c_str());
+        this->log_WARNING_LO_RiskExplain(ex.alert_id, ex.pcyber, ex.bias, topArg);
     }
+    if(explainer.enabled()){ this->tlmWrite_ExplainDrops(explainer.drops()); }
 }
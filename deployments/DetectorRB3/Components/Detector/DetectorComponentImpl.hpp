@@ -4,6 +4,8 @@
 #include <vector>
 #include <mutex>
 #include "DetectorComponentAi.hpp"
+#include "ShadowScorer.hpp"
+#include "PathExplainer.hpp"
 #include "deployments/DetectorRB3/Components/Detector/DetectorComponentAc.hpp"
 #include <Fw/Buffer/Buffer.hpp>
 #include <Fw/Types/String.hpp>
@@ -18,12 +20,18 @@ class DetectorComponentImpl : public ::DetectorRB3::DetectorComponentBase {
   private:
     // Port handler: FeatureIn
     void FeatureIn_handler(FwIndexType portNum, Fw::Buffer& fwBuffer) override;
+    // Port handler: schedIn (rate group tick publishes drift telemetry)
+    void schedIn_handler(FwIndexType portNum, U32 context) override;
 
     // Helpers
     void load_threshold(const std::string& config_dir);
+    double nowSeconds();
 
     // Runtime
     DetectorComponentAi ai;
-    std::mutex mu;
+    ShadowScorer shadow;  // optional candidate model set from <config_dir>/shadow
+    PathExplainer explainer;  // per-alert feature attribution against the active forest
+    std::mutex mu;  // bring-up ingest runs on the frame worker, schedIn on the component thread
     double tau{0.5};
+    U32 alertSeq{0};  // ties each RiskAlert to its RiskExplain
 };
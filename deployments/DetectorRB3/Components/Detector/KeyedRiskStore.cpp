@@ -0,0 +1,126 @@
+#include "KeyedRiskStore.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace {
+constexpr std::uint16_t kSaturate = 0xFFFF;
+
+inline std::size_t homeSlot(std::uint32_t key){
+    // Fibonacci hashing onto the power-of-two table
+    return static_cast<std::size_t>((key * 2654435761U) >> 24) & (KeyedRiskStore::kSlots - 1);
+}
+inline std::uint8_t clampU8(double v){ return static_cast<std::uint8_t>(std::min(255.0, std::max(0.0, std::round(v)))); }
+inline std::uint16_t clampU16(double v){ return static_cast<std::uint16_t>(std::min(65535.0, std::max(0.0, std::round(v)))); }
+}  // namespace
+
+bool KeyedRiskStore::load(const std::string& path){
+    std::ifstream in(path);
+    if(!in) return false;
+    std::string k; double v;
+    std::string line;
+    while(std::getline(in, line)){
+        std::istringstream ls(line);
+        if(!(ls>>k>>v)) continue;  // blank or # comment line
+        if(k=="keyed_ref") ref=v;
+        else if(k=="keyed_threshold" && v>0) threshold=v;
+        else if(k=="keyed_halflife_s" && v>0) halflife=v;
+    }
+    return true;
+}
+
+std::uint32_t KeyedRiskStore::pack(const Key& k){
+    return (static_cast<std::uint32_t>(k.link) << 24) | (static_cast<std::uint32_t>(k.subsystem) << 16) | k.opcode;
+}
+
+KeyedRiskStore::Key KeyedRiskStore::unpack(std::uint32_t v){
+    return Key{static_cast<std::uint8_t>(v >> 24), static_cast<std::uint8_t>((v >> 16) & 0xFF), static_cast<std::uint16_t>(v & 0xFFFF)};
+}
+
+KeyedRiskStore::Key KeyedRiskStore::keyOf(unsigned int link, const std::vector<double>& x){
+    Key k{clampU8(link), 0, 0};
+    if(x.size() > kSubsystemIndex){
+        k.opcode = clampU16(x[kOpcodeIndex]);
+        k.subsystem = clampU8(x[kSubsystemIndex]);
+    }
+    return k;
+}
+
+KeyedRiskStore::Result KeyedRiskStore::update(const Key& k, double ts, double risk){
+    const std::uint32_t key = pack(k);
+    const std::size_t home = homeSlot(key);
+    Slot* s = nullptr;
+    Slot* freeSlot = nullptr;
+    for(std::size_t i=0; i<kProbe; ++i){
+        Slot& c = slots[(home + i) & (kSlots - 1)];
+        if(c.used && c.key == key){ s = &c; break; }
+        // A slot whose evidence has drained to zero is as good as empty
+        if(!freeSlot && (!c.used || c.acc <= 0.0f)) freeSlot = &c;
+    }
+    if(!s){
+        // Keys at or below ref carry no evidence; only admit those that would start accumulating
+        if(risk <= ref) return Result{k, 0.0f, false};
+        if(!freeSlot){
+            // Second chance over the probe window: referenced slots lose their bit and are only
+            // considered once nothing unreferenced is left. Among candidates the victim is the one
+            // with the least decayed evidence, so a spray of fresh keys cannot flush a campaign.
+            Slot* victim = nullptr;
+            double victimEv = 0.0;
+            bool victimRef = true;
+            for(std::size_t i=0; i<kProbe; ++i){
+                Slot& c = slots[(home + i) & (kSlots - 1)];
+                const double dt = ts - c.ts;
+                const double ev = dt > 0.0 ? c.acc * std::exp2(-dt / halflife) : c.acc;
+                const bool wasRef = c.ref != 0;
+                c.ref = 0;
+                if(!victim || (victimRef && !wasRef) || (victimRef == wasRef && ev < victimEv)){
+                    victim = &c;
+                    victimEv = ev;
+                    victimRef = wasRef;
+                }
+            }
+            // The newcomer's first step must outweigh what the victim has accumulated
+            if(risk - ref <= victimEv) return Result{k, 0.0f, false};
+            freeSlot = victim;
+            ++evicted;
+        }
+        s = freeSlot;
+        *s = Slot{key, 0.0f, ts, 0, 0, 1, 1, 1};
+    }
+
+    const double dt = ts - s->ts;
+    const double decay = dt > 0.0 ? std::exp2(-dt / halflife) : 1.0;
+    const double acc = std::max(0.0, s->acc * decay + (risk - ref));
+    s->acc = static_cast<float>(acc);
+    s->ts = std::max(s->ts, ts);
+    s->ref = 1;
+    if(s->frames < kSaturate) ++s->frames;
+    if(risk > ref && s->hits < kSaturate) ++s->hits;
+
+    bool alert = false;
+    if(s->armed && acc > threshold){ alert = true; s->armed = 0; }
+    else if(!s->armed && acc < 0.5 * threshold){ s->armed = 1; }
+    return Result{k, s->acc, alert};
+}
+
+std::size_t KeyedRiskStore::top(Hot* out, std::size_t n, double now) const{
+    std::size_t m = 0;
+    for(const Slot& c : slots){
+        if(!c.used || c.acc <= 0.0f) continue;
+        // Keys only decay when they see traffic; age quiet ones to now before ranking
+        const double dt = now - c.ts;
+        const float ev = dt > 0.0 ? static_cast<float>(c.acc * std::exp2(-dt / halflife)) : c.acc;
+        // Insertion into a tiny sorted prefix; n is kTopN-sized
+        std::size_t pos = std::min(m, n);
+        while(pos > 0 && out[pos - 1].evidence < ev){
+            if(pos < n) out[pos] = out[pos - 1];
+            --pos;
+        }
+        if(pos < n){
+            out[pos] = Hot{unpack(c.key), ev, c.frames, c.hits};
+            if(m < n) ++m;
+        }
+    }
+    return m;
+}
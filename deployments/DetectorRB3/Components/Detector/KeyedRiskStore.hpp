@@ -0,0 +1,67 @@
+#pragma once
+// Fixed-capacity rolling risk per (link, subsystem, opcode).
+//
+// Slots live in one flat open-addressed table with a short probe window.
+// Only keys with evidence are admitted, and drained slots are reused first.
+// When a window is still full, a second-chance sweep over that window picks
+// the unreferenced slot with the least evidence, and the newcomer only takes
+// it if its first step outweighs that evidence. Memory never grows past kSlots
+// entries, and a spray of fresh keys cannot flush an accumulating one. Each
+// key holds a decayed CUSUM of (risk - ref) and alerts when that evidence
+// crosses a threshold. A slow campaign keeping one opcode slightly elevated therefore
+// alerts even though no single frame crosses tau.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class KeyedRiskStore {
+  public:
+    static constexpr std::size_t kSlots = 256;  // 24 B each, 6 KiB total
+    static constexpr std::size_t kProbe = 8;
+    static constexpr std::size_t kTopN = 4;
+    // Feature indices per feature_schema.csv (ts excluded)
+    static constexpr std::size_t kOpcodeIndex = 9;
+    static constexpr std::size_t kSubsystemIndex = 10;
+
+    struct Key { std::uint8_t link; std::uint8_t subsystem; std::uint16_t opcode; };
+    struct Result { Key key; float evidence; bool alert; };
+    struct Hot { Key key; float evidence; std::uint16_t frames; std::uint16_t hits; };
+
+    // Reads keyed_ref, keyed_threshold and keyed_halflife_s; missing keys keep defaults.
+    bool load(const std::string& path);
+
+    static Key keyOf(unsigned int link, const std::vector<double>& x);
+
+    // O(1): one probe window, one decay, one CUSUM step. ts is in seconds.
+    Result update(const Key& k, double ts, double risk);
+
+    // Hottest keys by evidence decayed to now, highest first; returns how many were written.
+    std::size_t top(Hot* out, std::size_t n, double now) const;
+
+    // Cumulative count of live keys displaced by newcomers; steady growth means kSlots is too small.
+    std::uint32_t evictions() const { return evicted; }
+
+  private:
+    struct Slot {
+        std::uint32_t key;
+        float acc;
+        double ts;
+        std::uint16_t frames;  // saturating
+        std::uint16_t hits;    // saturating, frames with risk above ref
+        std::uint8_t used;
+        std::uint8_t ref;      // clock reference bit
+        std::uint8_t armed;    // cleared on alert, re-armed below half threshold
+    };
+    static_assert(sizeof(Slot) <= 24, "KeyedRiskStore slot grew past its cache budget");
+
+    static std::uint32_t pack(const Key& k);
+    static Key unpack(std::uint32_t v);
+
+    std::array<Slot, kSlots> slots{};
+    double ref{0.25};
+    double threshold{8.0};
+    double halflife{120.0};
+    std::uint32_t evicted{0};
+};
@@ -0,0 +1,8 @@
+#pragma once
+// Width of the model feature vector, shared by everything that sizes per-feature state.
+// Order is feature_schema.csv without ts: 16 measured features, the reserved rule_score
+// at index 16 and the guard bits at index 17. FeatureVectorArrayAi.xml and Detector.fpp
+// size the FeatureDrift channel to match.
+#include <cstddef>
+
+constexpr std::size_t kModelFeatures = 18;
@@ -0,0 +1,188 @@
+#include "NoveltyScorer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Smoothing rates, in frames: fast ~32, slow ~1024, score baseline ~256.
+constexpr float kFastRate = 1.0f / 32.0f;
+constexpr float kSlowRate = 1.0f / 1024.0f;
+constexpr double kScoreRate = 1.0 / 256.0;
+// Frugal quantile band and step size in slow standard deviations.
+constexpr float kQuantileLo = 0.02f;
+constexpr float kQuantileHi = 0.98f;
+constexpr float kQuantileStep = 0.1f;
+// Slow moments move ~1/1024 per frame, so cached scales are refreshed every 16 frames.
+constexpr std::uint32_t kScaleRefreshMask = 15;
+// Frames seen only matter until warm-up ends and every smoother reaches its floor rate (1024 frames).
+// Saturating well past both keeps a long soak from wrapping the count and re-seeding the link.
+constexpr std::uint32_t kSeenCap = 1U << 16;
+// Histogram growth per frame (decay with ~2048 frame memory), rescale point and Laplace prior.
+constexpr double kHistGrowth = 1.0 / (1.0 - 1.0 / 2048.0);
+constexpr double kHistRescale = 1e12;
+constexpr double kHistPrior = 0.5;
+// Standardized values are clipped, projections are binned over [-range, range].
+constexpr float kZClip = 8.0f;
+constexpr float kProjRange = 6.0f;
+constexpr float kBinScale = NoveltyScorer::kBins / (2.0f * kProjRange);
+// Tail excess (in quantile spreads) and projection score (in baseline sds) below slack count as familiar.
+constexpr double kTailSlack = 0.3;
+constexpr double kTailScale = 0.3;
+constexpr double kProjSlack = 3.0;
+constexpr double kProjScale = 3.0;
+// Projections and tail excess use only measured features; reserved rule_score and guard bits are
+// excluded, as RuleGuard already scores them.
+constexpr std::size_t kMeasuredFeatures = 16;
+// Quantization step of the integer-coded fields (fivetuple_changes, opcode, subsystem, mode,
+// param_bucket). It floors their scale, so a field that sat on one value does not collapse to
+// zero spread, and one step past the quantile band counts as rounding, not tail.
+constexpr float kStep[NoveltyScorer::kLanes] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1};
+
+inline float sdOf(float var, float mean){ return std::sqrt(var) + 1e-3f * (1.0f + std::fabs(mean)); }
+inline double squash(double e){ return e > 0.0 ? 1.0 - std::exp(-e) : 0.0; }
+inline std::uint64_t nextRand(std::uint64_t& s){
+    // xorshift64*: fixed sequence on every platform so projections match across builds
+    s ^= s >> 12; s ^= s << 25; s ^= s >> 27;
+    return s * 2685821657736338717ULL;
+}
+}  // namespace
+
+NoveltyScorer::NoveltyScorer(){
+    std::uint64_t s = 0x5eedf00dULL;
+    for(auto& p : proj){
+        for(std::size_t t=0; t<kProjectionTerms; ++t){
+            std::uint8_t idx = 0;
+            bool dup = true;
+            while(dup){
+                idx = static_cast<std::uint8_t>(nextRand(s) % kMeasuredFeatures);
+                dup = std::find(p.idx, p.idx + t, idx) != p.idx + t;
+            }
+            p.idx[t] = idx;
+            p.w[t] = (nextRand(s) & 1U) ? 1.0f : -1.0f;
+        }
+    }
+    reset();
+}
+
+void NoveltyScorer::reset(){
+    for(auto& L : links){
+        L.meanFast.fill(0.0f);
+        L.meanSlow.fill(0.0f);
+        L.varSlow.fill(0.0f);
+        L.qLo.fill(0.0f);
+        L.qHi.fill(0.0f);
+        L.sd.fill(1.0f);
+        L.invSd.fill(1.0f);
+        L.invSpread.fill(1.0f);
+        for(auto& h : L.hist) h.fill(0.0f);
+        L.histGain = 1.0;
+        L.histMass = 0.0;
+        L.scoreMean = 0.0;
+        L.scoreVar = 0.0;
+        L.scoreInvSd = 0.0;
+        L.seen = 0;
+        L.refresh = 0;
+    }
+}
+
+double NoveltyScorer::forestTerm(double pmax){
+    // 1 below 0.45, 0 above 0.55: the old 0.5 cut with a soft edge
+    return std::min(1.0, std::max(0.0, (0.55 - pmax) / 0.1));
+}
+
+double NoveltyScorer::update(unsigned int link, const std::vector<double>& x){
+    if(link >= kMaxLinks) return 0.0;
+    LinkState& L = links[link];
+    const std::size_t n = std::min(x.size(), kModelFeatures);
+    FeatureStats v{};
+    for(std::size_t j=0; j<n; ++j) v[j] = static_cast<float>(x[j]);
+    if(L.seen == 0){
+        L.meanFast = L.meanSlow = L.qLo = L.qHi = v;
+    }
+    const bool warm = L.seen >= kWarmupFrames;
+    if(!warm || (L.refresh & kScaleRefreshMask) == 0){
+        for(std::size_t j=0; j<kLanes; ++j){
+            L.sd[j] = std::max(sdOf(L.varSlow[j], L.meanSlow[j]), 0.5f * kStep[j]);
+            L.invSd[j] = 1.0f / L.sd[j];
+        }
+        for(std::size_t j=0; j<kMeasuredFeatures; ++j){
+            L.invSpread[j] = 1.0f / std::max({L.qHi[j] - L.qLo[j], L.sd[j], kStep[j]});
+        }
+        L.scoreInvSd = 1.0 / std::sqrt(L.scoreVar + 1e-9);
+    }
+
+    // One branch-free pass over all features: standardize and take the tail
+    // excess against the current state, then fold v into moments and quantiles.
+    // Absent trailing features stay at zero and never score.
+    const double age = 1.0 / (L.seen + 1.0);  // running-mean rate until each smoother's floor
+    const float fast = std::max(kFastRate, static_cast<float>(age));
+    const float slow = std::max(kSlowRate, static_cast<float>(age));
+    FeatureStats z;
+    FeatureStats t;
+    for(std::size_t j=0; j<kLanes; ++j){
+        const float d = v[j] - L.meanSlow[j];
+        z[j] = std::max(-kZClip, std::min(kZClip, d * L.invSd[j]));
+        t[j] = (std::max(L.qLo[j] - v[j], v[j] - L.qHi[j]) - kStep[j]) * L.invSpread[j];
+
+        const float step = kQuantileStep * L.sd[j];
+        L.qLo[j] += step * (v[j] > L.qLo[j] ? kQuantileLo : (v[j] < L.qLo[j] ? kQuantileLo - 1.0f : 0.0f));
+        L.qHi[j] += step * (v[j] > L.qHi[j] ? kQuantileHi : (v[j] < L.qHi[j] ? kQuantileHi - 1.0f : 0.0f));
+        L.meanFast[j] += fast * (v[j] - L.meanFast[j]);
+        L.meanSlow[j] += slow * d;
+        L.varSlow[j] = (1.0f - slow) * (L.varSlow[j] + slow * d * d);
+    }
+    const double tail = *std::max_element(t.begin(), t.begin() + kMeasuredFeatures);
+
+    // Projection histograms: average negative log density across projections,
+    // taken as one log of the product of bin probabilities.
+    std::size_t bins[kProjections];
+    double mass = 1.0;
+    const double prior = kHistPrior * L.histGain;
+    const double invDenom = 1.0 / (L.histMass + prior * kBins);
+    for(std::size_t k=0; k<kProjections; ++k){
+        const Projection& p = proj[k];
+        float y = kProjRange;
+        for(std::size_t i=0; i<kProjectionTerms; ++i) y += p.w[i] * z[p.idx[i]];
+        const int b = static_cast<int>(y * kBinScale);
+        bins[k] = static_cast<std::size_t>(std::max(0, std::min(static_cast<int>(kBins) - 1, b)));
+        mass *= (L.hist[k][bins[k]] + prior) * invDenom;
+    }
+    const double s = -std::log(mass) / static_cast<double>(kProjections);
+
+    double nov = 0.0;
+    if(warm){
+        const double zs = (s - L.scoreMean) * L.scoreInvSd;
+        nov = squash(std::max((tail - kTailSlack) / kTailScale, (zs - kProjSlack) / kProjScale));
+    }
+
+    // Histograms decay lazily: the increment grows instead of every bin shrinking.
+    L.histGain *= kHistGrowth;
+    for(std::size_t k=0; k<kProjections; ++k){
+        L.hist[k][bins[k]] += static_cast<float>(L.histGain);
+    }
+    L.histMass += L.histGain;
+    if(L.histGain > kHistRescale){
+        const double inv = 1.0 / L.histGain;
+        for(auto& h : L.hist) for(auto& c : h) c = static_cast<float>(c * inv);
+        L.histMass *= inv;
+        L.histGain = 1.0;
+    }
+
+    const double sr = std::max(kScoreRate, age);
+    const double ds = s - L.scoreMean;
+    L.scoreMean += sr * ds;
+    L.scoreVar = (1.0 - sr) * (L.scoreVar + sr * ds * ds);
+    if(L.seen < kSeenCap) ++L.seen;
+    ++L.refresh;
+    return nov;
+}
+
+void NoveltyScorer::drift(FeatureArray& out) const{
+    out.fill(0.0f);
+    for(const auto& L : links){
+        if(L.seen < kWarmupFrames) continue;
+        for(std::size_t j=0; j<kModelFeatures; ++j){
+            const float d = std::fabs(L.meanFast[j] - L.meanSlow[j]) / sdOf(L.varSlow[j], L.meanSlow[j]);
+            out[j] = std::max(out[j], d);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+// Streaming novelty and drift scoring with constant memory per link.
+//
+// Each link keeps exponentially weighted per-feature moments, a pair of
+// frugal quantile estimates per feature, and decayed histograms over a fixed
+// set of sparse random projections (LODA-style). Scoring and learning are a
+// single O(features + projections) pass with no allocation.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ModelFeatures.hpp"
+
+class NoveltyScorer {
+  public:
+    // Per-feature state is padded to whole SIMD vectors; padding lanes stay zero and never score.
+    static constexpr std::size_t kLanes = (kModelFeatures + 3) & ~std::size_t{3};
+    static constexpr std::size_t kMaxLinks = 4;
+    static constexpr std::size_t kProjections = 8;
+    static constexpr std::size_t kProjectionTerms = 3;
+    static constexpr std::size_t kBins = 16;
+    static constexpr std::uint32_t kWarmupFrames = 64;
+
+    using FeatureArray = std::array<float, kModelFeatures>;
+
+    NoveltyScorer();
+
+    // Scores x against the link's history (0 = familiar, 1 = novel), then folds x into it.
+    // Links at or above kMaxLinks score 0 and leave no state rather than sharing another link's history.
+    double update(unsigned int link, const std::vector<double>& x);
+
+    // Per-feature drift: |fast mean - slow mean| in slow standard deviations, max over warm links.
+    void drift(FeatureArray& out) const;
+
+    // Soft replacement for the old max(p) < 0.5 flag on the forest output.
+    static double forestTerm(double pmax);
+
+    void reset();
+
+  private:
+    struct Projection {
+        std::uint8_t idx[kProjectionTerms];
+        float w[kProjectionTerms];
+    };
+    using FeatureStats = std::array<float, kLanes>;
+    // Per-feature state is float and column-wise so the update loops vectorize without a scalar tail.
+    struct LinkState {
+        FeatureStats meanFast;
+        FeatureStats meanSlow;
+        FeatureStats varSlow;
+        FeatureStats qLo;
+        FeatureStats qHi;
+        FeatureStats sd;     // cached scale, refreshed periodically
+        FeatureStats invSd;
+        FeatureStats invSpread;  // 1 / max(qHi - qLo, sd, step), refreshed with sd
+        std::array<std::array<float, kBins>, kProjections> hist;
+        double histGain;
+        double histMass;
+        double scoreMean;
+        double scoreVar;
+        double scoreInvSd;
+        std::uint32_t seen;     // saturating; only distinguishes cold, warming and settled
+        std::uint32_t refresh;  // free-running; wraps harmlessly, only its low bits pace the scale refresh
+    };
+
+    std::array<Projection, kProjections> proj;
+    std::array<LinkState, kMaxLinks> links;
+};
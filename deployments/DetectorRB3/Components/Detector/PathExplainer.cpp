@@ -0,0 +1,87 @@
+#include "PathExplainer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace {
+// Model feature 16 is derived, not a schema column; guard bits sit at 17.
+constexpr std::size_t kRuleScore = 16;
+constexpr std::size_t kGuardBits = 17;
+}  // namespace
+
+PathExplainer::~PathExplainer(){ stop(); }
+
+bool PathExplainer::load(const Forest& forest, const std::string& schema_path){
+    model = nullptr;
+    for(std::size_t i=0; i<names.size(); ++i){ names[i] = "f" + std::to_string(i); }
+    names[kRuleScore] = "rule_score";
+    names[kGuardBits] = "guard_violation_bits";
+
+    // Header is ts followed by features 0..15 and guard bits, as in the frame CSV
+    std::ifstream in(schema_path);
+    std::string header;
+    if(in && std::getline(in, header)){
+        std::stringstream ss(header);
+        std::string tok;
+        std::size_t col = 0;
+        while(std::getline(ss, tok, ',')){
+            if(!tok.empty() && tok.back() == '\r') tok.pop_back();
+            if(col >= 1 && col <= kRuleScore) names[col - 1] = tok;
+            else if(col == kGuardBits) names[kGuardBits] = tok;
+            ++col;
+        }
+    }
+
+    if(forest.size() == 0 || forest.size() > kMaxTrees || forest.maxNodes() > kMaxNodes) return false;
+    model = &forest;
+    return true;
+}
+
+void PathExplainer::start(){
+    if(!enabled()) return;
+    jobs.start([this](const Job& job){
+        Explanation ex;
+        explain(job, ex);
+        if(!results.push(ex)) dropped.fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
+void PathExplainer::stop(){ jobs.stop(); }
+
+void PathExplainer::submit(std::uint32_t alert_id, double risk, const std::vector<int>& leaves){
+    Job job;
+    job.alert_id = alert_id;
+    job.risk = static_cast<float>(risk);
+    job.ntrees = static_cast<std::uint16_t>(std::min(leaves.size(), kMaxTrees));
+    for(std::size_t t=0; t<job.ntrees; ++t){ job.leaves[t] = static_cast<std::uint16_t>(leaves[t]); }
+    jobs.submit(job);
+}
+
+bool PathExplainer::poll(Explanation& out){ return results.pop(out); }
+
+void PathExplainer::explain(const Job& job, Explanation& out) const{
+    std::array<int, kMaxTrees> leaves;
+    for(std::size_t t=0; t<job.ntrees; ++t){ leaves[t] = job.leaves[t]; }
+    std::array<double, kModelFeatures> contrib{};
+    const double bias = model->explain(leaves.data(), kClass, contrib.data(), contrib.size());
+
+    std::array<std::uint8_t, kModelFeatures> order;
+    double total = bias;
+    for(std::size_t i=0; i<order.size(); ++i){
+        order[i] = static_cast<std::uint8_t>(i);
+        total += contrib[i];
+    }
+    std::partial_sort(order.begin(), order.begin() + kTopK, order.end(),
+                      [&](std::uint8_t a, std::uint8_t b){ return std::fabs(contrib[a]) > std::fabs(contrib[b]); });
+
+    out.alert_id = job.alert_id;
+    out.risk = job.risk;
+    out.pcyber = static_cast<float>(total);
+    out.bias = static_cast<float>(bias);
+    out.count = 0;
+    for(std::size_t k=0; k<kTopK; ++k){
+        if(contrib[order[k]] == 0.0) break;
+        out.top[out.count++] = Share{order[k], static_cast<float>(contrib[order[k]])};
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+// Explains alerting frames by decision-path attribution on a low-priority worker.
+//
+// The active forest already records the leaf it reached in each tree; on an alert
+// the component copies those leaf indices into a lock-free ring. The worker walks
+// each leaf back to its root and credits every split's change in P(cyber) to the
+// feature it tested. The largest shares come back through a second ring for the
+// component thread to publish, so frames below tau pay nothing beyond the leaf stores.
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DetectorComponentAi.hpp"
+#include "SpscRing.hpp"
+#include "SpscWorker.hpp"
+
+class PathExplainer {
+  public:
+    static constexpr std::size_t kMaxTrees = 128;
+    static constexpr std::size_t kMaxNodes = std::size_t{1} << 16;  // per tree; leaf indices travel as uint16_t
+    static constexpr std::size_t kTopK = 4;
+    static constexpr std::size_t kQueueDepth = 32;  // alerts are rare; a storm beyond this is counted, not queued
+    static constexpr int kClass = 1;                // cyber
+
+    // Alerting frame as seen by the active path.
+    struct Job {
+        std::uint32_t alert_id;
+        float risk;
+        std::uint16_t ntrees;
+        std::array<std::uint16_t, kMaxTrees> leaves;
+    };
+
+    struct Share {
+        std::uint8_t feature;
+        float contrib;  // signed change in P(cyber) attributed to the feature
+    };
+
+    struct Explanation {
+        std::uint32_t alert_id;
+        float risk;
+        float pcyber;  // bias + sum of all shares
+        float bias;    // forest-mean root P(cyber), the prior before any split
+        std::uint8_t count;
+        std::array<Share, kTopK> top;  // by |contrib|, largest first
+    };
+
+    ~PathExplainer();
+
+    // Binds the active forest and reads feature names from feature_schema.csv.
+    // Leaves attribution disabled if the forest has more than kMaxTrees trees or kMaxNodes nodes in any tree.
+    bool load(const Forest& forest, const std::string& schema_path);
+    bool enabled() const { return model != nullptr; }
+    void start();
+    void stop();
+
+    // Called on the active path for frames above tau; never blocks.
+    void submit(std::uint32_t alert_id, double risk, const std::vector<int>& leaves);
+    // Called on the component thread; false when nothing is ready.
+    bool poll(Explanation& out);
+
+    const std::string& name(std::size_t feature) const { return names[feature]; }
+    std::uint32_t drops() const { return jobs.drops() + dropped.load(std::memory_order_relaxed); }
+
+  private:
+    void explain(const Job& job, Explanation& out) const;
+
+    const Forest* model{nullptr};
+    std::array<std::string, kModelFeatures> names;
+
+    SpscRing<Explanation, kQueueDepth> results;
+    std::atomic<std::uint32_t> dropped{0};  // finished explanations the component thread had no room for
+
+    // Last, so the worker is joined before the results ring and names are destroyed
+    SpscWorker<Job, kQueueDepth> jobs;
+};
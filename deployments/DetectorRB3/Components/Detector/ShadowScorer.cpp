@@ -0,0 +1,96 @@
+#include "ShadowScorer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace {
+int argmax3(const std::vector<double>& p){ return (p[1]>p[0] && p[1]>p[2])?1:((p[2]>p[0] && p[2]>p[1])?2:0); }
+}  // namespace
+
+ShadowScorer::~ShadowScorer(){ stop(); }
+
+bool ShadowScorer::load(const std::string& dir, double active_tau){
+    loaded = false;
+    if(!forest.load(dir + "/forest.model")) return false;
+    // Without its own weights the candidate would be scored on the Calibrator defaults and every
+    // delta against the active risk would compare two different scales
+    if(!calib.load(dir + "/calibrator.cfg")) return false;
+    tau = active_tau;
+    // A candidate may ship its own threshold; otherwise compare against the active one
+    std::ifstream in(dir + "/calibrator.cfg");
+    std::string k; double v;
+    std::string line;
+    while(std::getline(in, line)){
+        std::istringstream ls(line);
+        if(!(ls >> k >> v)) continue;  // blank or # comment line
+        if(k == "threshold" || k == "tau") { tau = v; }
+    }
+    xbuf.assign(kModelFeatures, 0.0);
+    loaded = true;
+    return true;
+}
+
+void ShadowScorer::start(){
+    if(!loaded) return;
+    queue.start([this](const ShadowFrame& f){ score(f); });
+}
+
+void ShadowScorer::stop(){ queue.stop(); }
+
+void ShadowScorer::submit(const ShadowFrame& f){ queue.submit(f); }
+
+void ShadowScorer::score(const ShadowFrame& f){
+    const auto t0 = std::chrono::steady_clock::now();
+    for(std::size_t i=0; i<xbuf.size(); ++i){ xbuf[i] = f.x[i]; }
+    const auto p = forest.proba(xbuf);
+    const double nov = std::max(NoveltyScorer::forestTerm(std::max({p[0],p[1],p[2]})), static_cast<double>(f.nov_stream));
+    const double risk = calib.score(p[1], rules.rulescore(f.guard_bits), nov);
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+    const double delta = risk - f.active_risk;
+    const std::size_t bin = std::min(kDeltaBins - 1, static_cast<std::size_t>(std::fabs(delta) * kDeltaBins));
+    const bool shadowAlert = risk > tau;
+    const bool activeAlert = f.active_risk > tau;
+
+    std::lock_guard<std::mutex> lock(statsMu);
+    ++frames;
+    if(shadowAlert && !activeAlert) ++shadowOnly;
+    if(activeAlert && !shadowAlert) ++activeOnly;
+    ++winFrames;
+    if(argmax3(p) == f.active_class) ++winAgree;
+    winDelta += delta;
+    ++winDeltaHist[bin];
+    winLatencyUs += us;
+    winLatencyMaxUs = std::max(winLatencyMaxUs, us);
+}
+
+ShadowScorer::Stats ShadowScorer::snapshot(){
+    std::lock_guard<std::mutex> lock(statsMu);
+    Stats s{};
+    s.frames = frames;
+    s.drops = queue.drops();
+    s.shadow_only_alerts = shadowOnly;
+    s.active_only_alerts = activeOnly;
+    if(winFrames > 0){
+        const double n = winFrames;
+        s.agreement = static_cast<float>(winAgree / n);
+        s.delta_mean = static_cast<float>(winDelta / n);
+        s.latency_mean_us = static_cast<float>(winLatencyUs / n);
+        s.latency_max_us = static_cast<float>(winLatencyMaxUs);
+        // Upper edge of the bin holding the 95th percentile
+        const std::uint32_t target = static_cast<std::uint32_t>(std::ceil(0.95 * n));
+        std::uint32_t acc = 0;
+        std::size_t b = 0;
+        for(; b<kDeltaBins; ++b){ acc += winDeltaHist[b]; if(acc >= target) break; }
+        s.delta_p95 = static_cast<float>(std::min(b + 1, kDeltaBins)) / kDeltaBins;
+    }
+    winFrames = 0;
+    winAgree = 0;
+    winDelta = 0.0;
+    winLatencyUs = 0.0;
+    winLatencyMaxUs = 0.0;
+    winDeltaHist.fill(0);
+    return s;
+}
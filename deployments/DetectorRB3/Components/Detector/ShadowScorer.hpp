@@ -0,0 +1,79 @@
+#pragma once
+// Scores every frame with a candidate model set on a low-priority worker so a
+// retrain can be compared against live traffic before it is promoted.
+//
+// The active path only copies an already-parsed frame into a lock-free ring;
+// scoring, comparison and statistics happen on the worker.
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "DetectorComponentAi.hpp"
+#include "SpscWorker.hpp"
+
+// Parsed frame plus the active model's verdict, shared with the shadow model.
+struct ShadowFrame {
+    std::array<float, kModelFeatures> x;
+    unsigned int guard_bits;
+    float nov_stream;   // streaming novelty is model independent, computed once on the active path
+    float active_risk;
+    int active_class;
+};
+
+class ShadowScorer {
+  public:
+    static constexpr std::size_t kQueueDepth = 256;
+    static constexpr std::size_t kDeltaBins = 20;  // |risk delta| histogram over [0, 1]
+
+    struct Stats {
+        std::uint32_t frames;             // cumulative, scored by the shadow model
+        std::uint32_t drops;              // cumulative, ring full on the active path
+        std::uint32_t shadow_only_alerts; // cumulative, shadow > tau while active was not
+        std::uint32_t active_only_alerts; // cumulative, active > tau while shadow was not
+        float agreement;                  // window: fraction of frames with the same class
+        float delta_mean;                 // window: mean of shadow - active risk
+        float delta_p95;                  // window: 95th percentile of |shadow - active|
+        float latency_mean_us;            // window: shadow forest + calibrator time
+        float latency_max_us;
+    };
+
+    ~ShadowScorer();
+
+    // Loads forest.model and calibrator.cfg from dir; both are required. False leaves shadow scoring disabled.
+    bool load(const std::string& dir, double active_tau);
+    bool enabled() const { return loaded; }
+    void start();
+    void stop();
+
+    // Called on the active path; never blocks.
+    void submit(const ShadowFrame& f);
+
+    // Returns cumulative counters and the window since the previous snapshot.
+    Stats snapshot();
+
+  private:
+    void score(const ShadowFrame& f);
+
+    Forest forest;
+    Calibrator calib;
+    RuleGuard rules;
+    double tau{0.5};
+    bool loaded{false};
+
+    std::vector<double> xbuf;
+
+    std::mutex statsMu;
+    std::uint32_t frames{0};
+    std::uint32_t shadowOnly{0};
+    std::uint32_t activeOnly{0};
+    std::uint32_t winFrames{0};
+    std::uint32_t winAgree{0};
+    double winDelta{0.0};
+    double winLatencyUs{0.0};
+    double winLatencyMaxUs{0.0};
+    std::array<std::uint32_t, kDeltaBins> winDeltaHist{};
+
+    // Last, so the worker is joined before anything it scores with is destroyed
+    SpscWorker<ShadowFrame, kQueueDepth> queue;
+};
@@ -0,0 +1,38 @@
+#pragma once
+// Fixed-capacity single-producer/single-consumer ring. Neither side blocks or
+// allocates; push fails when the ring is full so the producer can count a drop.
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+template <typename T, std::size_t N>
+class SpscRing {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+  public:
+    bool push(const T& v){
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if(h - tail.load(std::memory_order_acquire) == N) return false;
+        buf[h & (N - 1)] = v;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side may ask; the answer can be stale by the time it is used.
+    bool empty() const{
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    bool pop(T& out){
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if(t == head.load(std::memory_order_acquire)) return false;
+        out = buf[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+    std::array<T, N> buf{};
+};
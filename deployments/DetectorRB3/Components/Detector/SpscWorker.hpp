@@ -0,0 +1,78 @@
+#pragma once
+// Low-priority consumer thread behind a lock-free ring, shared by the shadow
+// scorer and the alert explainer.
+//
+// The active path pushes and moves on: a full ring is counted as a drop, and
+// the wakeup never takes a lock. The worker drains the ring at a raised nice
+// value and parks on a WorkSignal when it is empty.
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include "SpscRing.hpp"
+#include "WorkSignal.hpp"
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+template <typename T, std::size_t N>
+class SpscWorker {
+  public:
+    // Worker nice value: well below the detector and rate group threads.
+    static constexpr int kNice = 10;
+    // Backstop for the last item of a burst whose wakeup was lost.
+    static constexpr std::chrono::milliseconds kIdleWait{100};
+
+    ~SpscWorker(){ stop(); }
+
+    // handle(const T&) runs on the worker for every item; a second start() is a no-op.
+    template <typename Handle>
+    void start(Handle handle){
+        if(running.exchange(true)) return;
+        worker = std::thread([this, handle]() mutable { run(handle); });
+    }
+
+    void stop(){
+        running.store(false);
+        wake.notify();
+        if(worker.joinable()) worker.join();
+    }
+
+    // Producer side; never blocks. Every successful push notifies, see WorkSignal.
+    bool submit(const T& v){
+        if(!ring.push(v)){
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        wake.notify();
+        return true;
+    }
+
+    // Cumulative items refused because the ring was full.
+    std::uint32_t drops() const { return dropped.load(std::memory_order_relaxed); }
+
+  private:
+    template <typename Handle>
+    void run(Handle& handle){
+#ifdef __linux__
+        ::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), kNice);
+#endif
+        T item;
+        while(running.load()){
+            if(!ring.pop(item)){
+                wake.wait([this]{ return !ring.empty() || !running.load(); }, kIdleWait);
+                continue;
+            }
+            handle(item);
+        }
+    }
+
+    SpscRing<T, N> ring;
+    WorkSignal wake;
+    std::atomic<bool> running{false};
+    std::atomic<std::uint32_t> dropped{0};
+    std::thread worker;
+};
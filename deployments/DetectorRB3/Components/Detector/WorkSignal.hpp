@@ -0,0 +1,28 @@
+#pragma once
+// Parks a ring consumer between bursts without making the producer block.
+//
+// notify() never takes the lock, so a wakeup that races the consumer's last
+// emptiness check can be missed. The producer therefore notifies on every
+// push, not only on the first one into an empty ring, so a missed wakeup
+// costs at most one frame interval. wait() is still bounded for the last
+// frame of a burst, and the consumer rechecks its ring on return either way.
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+class WorkSignal {
+  public:
+    // Producer side: call after every successful push. With no waiter this stays in user space.
+    void notify(){ cv.notify_one(); }
+
+    // Consumer side: returns once ready() holds or the bound expires.
+    template <typename Ready>
+    void wait(Ready ready, std::chrono::milliseconds bound){
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait_for(lock, bound, ready);
+    }
+
+  private:
+    std::mutex mu;
+    std::condition_variable cv;
+};
@@ -2,12 +2,16 @@
 #include <fstream>
 #include <string>
 #include <cmath>
+#include <sstream>
 static double s_sig(double z){ return 1.0/(1.0+std::exp(-z)); }
 bool Calibrator::load(const std::string& path){
     std::ifstream in(path);
     if(!in) return false;
     std::string k; double v;
-    while(in>>k>>v){
+    std::string line;
+    while(std::getline(in, line)){
+        std::istringstream ls(line);
+        if(!(ls>>k>>v)) continue;  // blank or # comment line
         if(k=="w_pcyber") w_p=v;
         else if(k=="w_rule") w_r=v;
         else if(k=="w_novelty") w_n=v;
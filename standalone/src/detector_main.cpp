@@ -2,12 +2,14 @@
 #include "Calibrator.hpp"
 #include "RuleGuard.hpp"
 #include "FeatureFrame.hpp"
+#include "NoveltyScorer.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <iomanip>
 static void split(const std::string& s, char d, std::vector<std::string>& out){ out.clear(); std::stringstream ss(s); std::string tok; while(std::getline(ss,tok,d)) out.push_back(tok); }
 static bool exists(const std::string& p){ std::ifstream f(p); return f.good(); }
 int main(int argc, char** argv){
@@ -15,7 +17,7 @@ int main(int argc, char** argv){
     std::string calib_path = "deployments/DetectorRB3/config/calibrator.cfg";
     if(!exists(model_path)) model_path = "../deployments/DetectorRB3/config/forest.model";
     if(!exists(calib_path)) calib_path = "../deployments/DetectorRB3/config/calibrator.cfg";
-    Forest forest; Calibrator calib; forest.load(model_path); calib.load(calib_path);
+    Forest forest; Calibrator calib; NoveltyScorer novel; forest.load(model_path); calib.load(calib_path);
     std::istream* in = &std::cin; std::ifstream f;
     if(argc>1){ f.open(argv[1]); if(f) in=&f; }
     std::string line; std::vector<std::string> tok;
@@ -34,12 +36,12 @@ int main(int argc, char** argv){
         fr.x[17] = static_cast<double>(fr.guard_bits);
         auto p = forest.proba(fr.x);
         double pcyber = p[1];
-        double novelty = (std::max({p[0],p[1],p[2]})<0.5)?1.0:0.0;
+        double novelty = std::max(NoveltyScorer::forestTerm(std::max({p[0],p[1],p[2]})), novel.update(0, fr.x));
         RuleGuard rg; rg.setBits(fr.guard_bits);
         double rs = rg.rulescore();
         double risk = calib.score(pcyber, rs, novelty);
         int cls = (p[1]>p[0] && p[1]>p[2])?1:((p[2]>p[0] && p[2]>p[1])?2:0);
-        std::cout<<fr.ts<<","<<risk<<","<<cls<<","<<rg.reason()<<",pcy="<<pcyber<<",nov="<<(novelty>0.5?"y":"n")<<std::endl;
+        std::cout<<std::fixed<<std::setprecision(6)<<fr.ts<<std::defaultfloat<<std::setprecision(6)<<","<<risk<<","<<cls<<","<<rg.reason()<<",pcy="<<pcyber<<",nov="<<novelty<<std::endl;
     }
     return 0;
 }
@@ -0,0 +1,174 @@
+// Checks for PathExplainer: model bounds, the worker hand-off, and drop accounting.
+//
+// Alerting frames are scored with the active forest and their leaf indices handed to
+// the explainer as the Detector does. Build with `make tsan` to run the same scenario
+// under ThreadSanitizer.
+//
+// Usage: explain_check [config_dir]   (default ../../deployments/DetectorRB3/config)
+#include "FrameGen.hpp"
+#include "PathExplainer.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+constexpr int kBursts = 200;
+constexpr std::size_t kBurstAlerts = 16;  // half of PathExplainer::kQueueDepth
+constexpr std::size_t kStormAlerts = 4 * PathExplainer::kQueueDepth;
+constexpr double kPcyberTolerance = 1e-5;  // explanations travel as float
+
+int g_failures = 0;
+
+void expect(bool ok, const char* name, const char* detail) {
+    std::printf("%s %s: %s\n", ok ? "PASS" : "FAIL", name, detail);
+    if (!ok) ++g_failures;
+}
+
+// A tree whose leaf indices do not fit a Job's uint16_t must leave attribution disabled.
+void oversizedTreeIsRejected(const std::string& configDir) {
+    char path[] = "/tmp/explain_checkXXXXXX";
+    const int fd = ::mkstemp(path);
+    if (fd < 0) {
+        expect(false, "oversized tree rejected", "mkstemp failed");
+        return;
+    }
+    ::close(fd);
+    const std::size_t nodes = PathExplainer::kMaxNodes + 2;
+    {
+        std::ofstream out(path);
+        out << "n_trees 1\ntree " << nodes << "\n";
+        out << "0 0 0.5 1 2 0.34 0.33 0.33\n";
+        for (std::size_t i = 1; i < nodes; ++i) out << i << " 0 0 -1 -1 0.5 0.5 0.0\n";
+    }
+    Forest big;
+    const bool parsed = big.load(path);
+    std::remove(path);
+    PathExplainer explainer;
+    const bool loaded = explainer.load(big, configDir + "/feature_schema.csv");
+    char detail[120];
+    std::snprintf(detail, sizeof(detail), "%zu-node tree %s", nodes, loaded ? "accepted" : "refused");
+    expect(parsed && !loaded && !explainer.enabled(), "oversized tree rejected", detail);
+}
+
+struct Alert {
+    double pcyber;
+    std::vector<int> leaves;
+};
+
+// Alerting frames from the generator, scored by the active forest.
+std::vector<Alert> collectAlerts(const Forest& forest, std::size_t n) {
+    GenConfig cfg;
+    cfg.seed = 11;
+    cfg.label_probs[0] = 0.2;
+    cfg.label_probs[1] = 0.7;
+    cfg.label_probs[2] = 0.1;
+    FrameGen gen(cfg);
+    FrameGen::Features f;
+    std::vector<double> x(FrameGen::kFeatures);
+    std::vector<Alert> alerts;
+    while (alerts.size() < n) {
+        gen.next(f);
+        x.assign(f.begin(), f.end());
+        Alert a;
+        a.leaves.assign(forest.size(), 0);
+        const auto p = forest.proba(x, a.leaves.data());
+        if (p[1] < 0.5) continue;
+        a.pcyber = p[1];
+        alerts.push_back(std::move(a));
+    }
+    return alerts;
+}
+
+// Drains explanations the way the rate group tick does; returns how many matched their alert.
+std::size_t drain(PathExplainer& explainer, const std::vector<Alert>& alerts, std::size_t& mismatched) {
+    std::size_t got = 0;
+    PathExplainer::Explanation ex;
+    while (explainer.poll(ex)) {
+        ++got;
+        const Alert& a = alerts[ex.alert_id % alerts.size()];
+        if (std::fabs(ex.pcyber - a.pcyber) > kPcyberTolerance || ex.count == 0) ++mismatched;
+    }
+    return got;
+}
+
+// Paced bursts must all be explained, and each explanation must add up to its alert's P(cyber).
+void burstsAreExplained(const Forest& forest, const std::string& configDir) {
+    PathExplainer explainer;
+    if (!explainer.load(forest, configDir + "/feature_schema.csv")) {
+        expect(false, "bursts explained", "cannot load the explainer");
+        return;
+    }
+    explainer.start();
+    const std::vector<Alert> alerts = collectAlerts(forest, kBurstAlerts * 4);
+    std::uint32_t id = 0;
+    std::size_t got = 0;
+    std::size_t mismatched = 0;
+    for (int b = 0; b < kBursts; ++b) {
+        for (std::size_t i = 0; i < kBurstAlerts; ++i, ++id) {
+            const Alert& a = alerts[id % alerts.size()];
+            explainer.submit(id, a.pcyber, a.leaves);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        got += drain(explainer, alerts, mismatched);
+    }
+    for (int i = 0; i < 100 && got + explainer.drops() < id; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        got += drain(explainer, alerts, mismatched);
+    }
+    explainer.stop();
+
+    char detail[160];
+    std::snprintf(detail, sizeof(detail), "submitted %u, explained %zu, dropped %u", id, got, explainer.drops());
+    expect(got == id && explainer.drops() == 0, "bursts explained", detail);
+    std::snprintf(detail, sizeof(detail), "%zu of %zu off by more than %.0e", mismatched, got, kPcyberTolerance);
+    expect(mismatched == 0, "shares add up to pcyber", detail);
+}
+
+// A storm past the queue depth with nobody draining: every alert is either explained or counted.
+void stormIsCounted(const Forest& forest, const std::string& configDir) {
+    PathExplainer explainer;
+    if (!explainer.load(forest, configDir + "/feature_schema.csv")) {
+        expect(false, "storm accounted", "cannot load the explainer");
+        return;
+    }
+    explainer.start();
+    const std::vector<Alert> alerts = collectAlerts(forest, kBurstAlerts);
+    for (std::uint32_t id = 0; id < kStormAlerts; ++id) {
+        const Alert& a = alerts[id % alerts.size()];
+        explainer.submit(id, a.pcyber, a.leaves);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    explainer.stop();
+    std::size_t mismatched = 0;
+    const std::size_t got = drain(explainer, alerts, mismatched);
+
+    char detail[160];
+    std::snprintf(detail, sizeof(detail), "submitted %zu, explained %zu, dropped %u", kStormAlerts, got,
+                  explainer.drops());
+    expect(got + explainer.drops() == kStormAlerts && explainer.drops() > 0, "storm accounted", detail);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::string configDir = argc > 1 ? argv[1] : "../../deployments/DetectorRB3/config";
+    Forest forest;
+    if (!forest.load(configDir + "/forest.model")) {
+        std::printf("FAIL cannot load %s/forest.model\n", configDir.c_str());
+        return 1;
+    }
+    oversizedTreeIsRejected(configDir);
+    burstsAreExplained(forest, configDir);
+    stormIsCounted(forest, configDir);
+    return g_failures;
+}
@@ -0,0 +1,116 @@
+// Behavioural checks for KeyedRiskStore with its default configuration
+// (keyed_ref 0.25, keyed_threshold 8, keyed_halflife_s 120).
+//
+// Each check prints one PASS/FAIL line; the exit status is the number of failures.
+#include "KeyedRiskStore.hpp"
+
+#include <cstdio>
+
+namespace {
+
+constexpr double kRef = 0.25;
+constexpr double kThreshold = 8.0;
+constexpr double kHalflife = 120.0;
+
+int g_failures = 0;
+
+void expect(bool ok, const char* name, const char* detail) {
+    std::printf("%s %s: %s\n", ok ? "PASS" : "FAIL", name, detail);
+    if (!ok) ++g_failures;
+}
+
+// A campaign key builds evidence slowly, then a spray of fresh keys, each only just above ref,
+// runs through the table. The spray churns the table but must not flush the campaign.
+void sprayDoesNotFlushCampaign() {
+    KeyedRiskStore store;
+    const KeyedRiskStore::Key campaign{1, 3, 77};
+    double ts = 0.0;
+    for (int i = 0; i < 40; ++i) store.update(campaign, ts += 1.0, kRef + 0.2);
+
+    KeyedRiskStore::Hot before[KeyedRiskStore::kTopN];
+    store.top(before, KeyedRiskStore::kTopN, ts);
+
+    for (int i = 0; i < 20000; ++i) {
+        const KeyedRiskStore::Key k{0, static_cast<std::uint8_t>(i % 250), static_cast<std::uint16_t>(i / 250)};
+        store.update(k, ts += 0.001, kRef + 0.05);
+    }
+
+    KeyedRiskStore::Hot hot[KeyedRiskStore::kTopN];
+    const std::size_t n = store.top(hot, KeyedRiskStore::kTopN, ts);
+    const bool onTop = n > 0 && hot[0].key.link == campaign.link && hot[0].key.subsystem == campaign.subsystem &&
+                       hot[0].key.opcode == campaign.opcode;
+    char detail[160];
+    std::snprintf(detail, sizeof(detail), "evidence %.2f before spray, %.2f after, %u evictions",
+                  before[0].evidence, onTop ? hot[0].evidence : 0.0f, store.evictions());
+    expect(onTop && store.evictions() > 0, "spray keeps campaign key", detail);
+
+    // The campaign keeps accumulating from what it had, not from a fresh slot
+    const KeyedRiskStore::Result r = store.update(campaign, ts += 1.0, kRef + 0.2);
+    std::snprintf(detail, sizeof(detail), "evidence %.2f on the next campaign frame", r.evidence);
+    expect(r.evidence > before[0].evidence * 0.8f, "campaign resumes with its evidence", detail);
+}
+
+// A newcomer whose first step does not outweigh the least-evidence victim is refused.
+void weakNewcomerIsRefused() {
+    KeyedRiskStore store;
+    double ts = 0.0;
+    // Fill every slot with evidence well above one small step
+    for (int i = 0; i < 4096; ++i) {
+        const KeyedRiskStore::Key k{0, static_cast<std::uint8_t>(i % 256), static_cast<std::uint16_t>(i / 256)};
+        for (int j = 0; j < 5; ++j) store.update(k, ts, kRef + 0.5);
+    }
+    const std::uint32_t evicted = store.evictions();
+    const KeyedRiskStore::Result r = store.update(KeyedRiskStore::Key{2, 9, 999}, ts, kRef + 0.05);
+    char detail[160];
+    std::snprintf(detail, sizeof(detail), "evidence %.2f, evictions %u -> %u", r.evidence, evicted, store.evictions());
+    expect(r.evidence == 0.0f && store.evictions() == evicted, "weak newcomer refused", detail);
+}
+
+// Alerts fire once on crossing the threshold and re-arm only after evidence falls below half of it.
+void alertRearmsAtHalfThreshold() {
+    KeyedRiskStore store;
+    const KeyedRiskStore::Key k{0, 1, 42};
+    double ts = 0.0;
+    int alerts = 0;
+    KeyedRiskStore::Result r{};
+    // Climb to the threshold at +1 per frame, then hold above it
+    for (int i = 0; i < 12; ++i) {
+        r = store.update(k, ts += 0.1, kRef + 1.0);
+        alerts += r.alert ? 1 : 0;
+    }
+    char detail[160];
+    std::snprintf(detail, sizeof(detail), "%d alert(s) while holding at %.2f", alerts, r.evidence);
+    expect(alerts == 1, "single alert above threshold", detail);
+
+    // Decay for 0.6 half-lives: still above half the threshold, so climbing back must stay silent
+    r = store.update(k, ts += kHalflife * 0.6, kRef);
+    const float above = r.evidence;
+    alerts = 0;
+    for (int i = 0; i < 12; ++i) {
+        r = store.update(k, ts += 0.1, kRef + 1.0);
+        alerts += r.alert ? 1 : 0;
+    }
+    std::snprintf(detail, sizeof(detail), "decayed to %.2f (half is %.1f), %d alert(s) on the climb back", above,
+                  0.5 * kThreshold, alerts);
+    expect(above > 0.5 * kThreshold && alerts == 0, "no re-arm above half threshold", detail);
+
+    // Decay for three half-lives, well below half the threshold: the next crossing alerts again
+    r = store.update(k, ts += kHalflife * 3.0, kRef);
+    const float below = r.evidence;
+    alerts = 0;
+    for (int i = 0; i < 12; ++i) {
+        r = store.update(k, ts += 0.1, kRef + 1.0);
+        alerts += r.alert ? 1 : 0;
+    }
+    std::snprintf(detail, sizeof(detail), "decayed to %.2f, %d alert(s) on the climb back", below, alerts);
+    expect(below < 0.5 * kThreshold && alerts == 1, "re-arm below half threshold", detail);
+}
+
+}  // namespace
+
+int main() {
+    sprayDoesNotFlushCampaign();
+    weakNewcomerIsRefused();
+    alertRearmsAtHalfThreshold();
+    return g_failures;
+}
@@ -0,0 +1,130 @@
+// Checks for ShadowScorer: candidate loading, and the worker hand-off under bursty load.
+//
+// The candidate is the active model set itself, so every frame must agree and no
+// frame may be lost between the producer and the worker. Build with
+// `make tsan` to run the same scenario under ThreadSanitizer.
+//
+// Usage: shadow_check [config_dir]   (default ../../deployments/DetectorRB3/config)
+#include "FrameGen.hpp"
+#include "ShadowScorer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+constexpr int kBursts = 1500;
+constexpr int kBurstFrames = 16;
+constexpr auto kBurstGap = std::chrono::milliseconds(2);  // 8k frames/s, well past the 2.56k/s ring-fill rate
+constexpr double kTau = 0.5;
+
+int g_failures = 0;
+
+void expect(bool ok, const char* name, const char* detail) {
+    std::printf("%s %s: %s\n", ok ? "PASS" : "FAIL", name, detail);
+    if (!ok) ++g_failures;
+}
+
+// A shadow directory with forest.model but no calibrator.cfg must not load.
+void calibratorIsRequired(const std::string& configDir) {
+    char dir[] = "/tmp/shadow_checkXXXXXX";
+    if (::mkdtemp(dir) == nullptr) {
+        expect(false, "calibrator.cfg required", "mkdtemp failed");
+        return;
+    }
+    const std::string model = std::string(dir) + "/forest.model";
+    {
+        std::ifstream in(configDir + "/forest.model", std::ios::binary);
+        std::ofstream out(model, std::ios::binary);
+        out << in.rdbuf();
+    }
+    ShadowScorer shadow;
+    const bool loaded = shadow.load(dir, kTau);
+    std::remove(model.c_str());
+    ::rmdir(dir);
+    expect(!loaded, "calibrator.cfg required", loaded ? "loaded with forest.model only" : "refused forest.model only");
+}
+
+// Bursts faster than the ring can absorb over one idle backstop; every frame must reach the worker.
+void burstsReachTheWorker(const std::string& configDir) {
+    Forest forest;
+    Calibrator calib;
+    RuleGuard rules;
+    ShadowScorer shadow;
+    if (!forest.load(configDir + "/forest.model") || !calib.load(configDir + "/calibrator.cfg") ||
+        !shadow.load(configDir, kTau)) {
+        expect(false, "bursts reach the worker", "cannot load the model set");
+        return;
+    }
+    shadow.start();
+
+    GenConfig cfg;
+    cfg.seed = 7;
+    FrameGen gen(cfg);
+    FrameGen::Features f;
+    std::vector<double> x(FrameGen::kFeatures);
+    std::uint32_t sent = 0;
+    for (int b = 0; b < kBursts; ++b) {
+        for (int i = 0; i < kBurstFrames; ++i) {
+            gen.next(f);
+            ShadowFrame sf;
+            for (std::size_t j = 0; j < sf.x.size(); ++j) {
+                sf.x[j] = static_cast<float>(f[j]);
+                x[j] = sf.x[j];
+            }
+            sf.guard_bits = static_cast<unsigned int>(f[FrameGen::kFeatures - 1]);
+            sf.nov_stream = 0.0f;
+            const auto p = forest.proba(x);
+            sf.active_risk = static_cast<float>(
+                calib.score(p[1], rules.rulescore(sf.guard_bits), NoveltyScorer::forestTerm(std::max({p[0], p[1], p[2]}))));
+            sf.active_class = (p[1] > p[0] && p[1] > p[2]) ? 1 : ((p[2] > p[0] && p[2] > p[1]) ? 2 : 0);
+            shadow.submit(sf);
+            ++sent;
+        }
+        std::this_thread::sleep_for(kBurstGap);
+    }
+
+    // Let the worker drain, then compare
+    ShadowScorer::Stats st{};
+    std::uint32_t prevFrames = 0;
+    float agreement = 1.0f;
+    float deltaMax = 0.0f;
+    for (int i = 0; i < 100; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        st = shadow.snapshot();
+        if (st.frames > prevFrames) {
+            // Window rates are only meaningful when the window scored something
+            agreement = std::min(agreement, st.agreement);
+            deltaMax = std::max(deltaMax, std::max(st.delta_mean, -st.delta_mean));
+        }
+        prevFrames = st.frames;
+        if (st.frames + st.drops >= sent) break;
+    }
+    shadow.stop();
+
+    char detail[200];
+    std::snprintf(detail, sizeof(detail), "sent %u, scored %u, dropped %u", sent, st.frames, st.drops);
+    expect(st.frames == sent && st.drops == 0, "bursts reach the worker", detail);
+    std::snprintf(detail, sizeof(detail), "agreement %.3f, |delta mean| %.2g, one-sided alerts %u/%u", agreement,
+                  deltaMax, st.shadow_only_alerts, st.active_only_alerts);
+    expect(agreement == 1.0f && deltaMax < 1e-6f && st.shadow_only_alerts == 0 && st.active_only_alerts == 0,
+           "identical candidate agrees", detail);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::string configDir = argc > 1 ? argv[1] : "../../deployments/DetectorRB3/config";
+    calibratorIsRequired(configDir);
+    burstsReachTheWorker(configDir);
+    return g_failures;
+}
@@ -0,0 +1,49 @@
+#pragma once
+// Native port of tools/sim/generator.py: same per-class feature distributions,
+// guard-bit rates, grouping and label noise, streamed one frame at a time.
+// Draws come from std::mt19937_64, so sequences differ from numpy for the same seed.
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+
+struct GenConfig {
+    double label_probs[3] = {0.68, 0.22, 0.10};  // benign, cyber, non-cyber
+    double label_noise = 0.05;
+    int group_min = 8;
+    int group_max = 24;
+    std::uint64_t seed = 0;
+};
+
+class FrameGen {
+  public:
+    static constexpr std::size_t kFeatures = 18;  // model order, matches FEATURE_NAMES
+    using Features = std::array<double, kFeatures>;
+
+    explicit FrameGen(const GenConfig& cfg);
+
+    // Fills x for the next frame and returns its (possibly noisy) label.
+    int next(Features& x);
+    std::uint32_t group() const { return groupId; }
+
+    // Appends one CSV row in sim_gen.py format: ts, 16 features, guard bits, optional label.
+    static void appendRow(std::string& out, double ts, const Features& x, int label);
+    // Header matching feature_schema.csv, plus the label column when requested.
+    static std::string header(bool withLabels);
+
+  private:
+    double normal(double mu, double sigma);
+    double uniform();
+    void startGroup();
+    void drawBase(Features& x);
+    void applyLabel(Features& x, int label);
+    unsigned int guardBits(int label);
+
+    GenConfig cfg;
+    std::mt19937_64 rng;
+    std::normal_distribution<double> gauss{0.0, 1.0};
+    std::uniform_real_distribution<double> unit{0.0, 1.0};
+    std::uint32_t groupId = 0;
+    int groupLabel = 0;
+    int groupLeft = 0;
+};
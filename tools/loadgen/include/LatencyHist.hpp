@@ -0,0 +1,63 @@
+#pragma once
+// Fixed-memory log-linear latency histogram (16 sub-buckets per power of two,
+// ~6% resolution) so hour-long soaks keep exact counts without storing samples.
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+class LatencyHist {
+  public:
+    static constexpr int kSub = 16;
+    static constexpr int kOctaves = 40;  // 1 us .. ~12 days
+
+    void record(double us){
+        if(us < 0.0) us = 0.0;
+        ++counts[bucketOf(us)];
+        ++total;
+        if(us > maxUs) maxUs = us;
+    }
+
+    void merge(const LatencyHist& o){
+        for(std::size_t i=0; i<counts.size(); ++i) counts[i] += o.counts[i];
+        total += o.total;
+        if(o.maxUs > maxUs) maxUs = o.maxUs;
+    }
+
+    void reset(){ counts.fill(0); total = 0; maxUs = 0.0; }
+
+    std::uint64_t count() const { return total; }
+    double max() const { return maxUs; }
+
+    // Upper edge of the bucket holding quantile q, in microseconds.
+    double percentile(double q) const{
+        if(total == 0) return 0.0;
+        const std::uint64_t target = static_cast<std::uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        std::uint64_t acc = 0;
+        for(std::size_t i=0; i<counts.size(); ++i){
+            acc += counts[i];
+            if(acc >= target) return upperEdge(i) < maxUs ? upperEdge(i) : maxUs;
+        }
+        return maxUs;
+    }
+
+  private:
+    static std::size_t bucketOf(double us){
+        if(us < 1.0) return 0;
+        int exp = 0;
+        const double frac = std::frexp(us, &exp);  // us = frac * 2^exp, frac in [0.5, 1)
+        const int octave = exp - 1;
+        if(octave >= kOctaves) return kOctaves * kSub - 1;
+        const int sub = static_cast<int>((frac * 2.0 - 1.0) * kSub);
+        return static_cast<std::size_t>(octave * kSub + sub);
+    }
+    static double upperEdge(std::size_t b){
+        const int octave = static_cast<int>(b) / kSub;
+        const int sub = static_cast<int>(b) % kSub;
+        return std::ldexp(1.0 + (sub + 1.0) / kSub, octave);
+    }
+
+    std::array<std::uint64_t, kOctaves * kSub> counts{};
+    std::uint64_t total = 0;
+    double maxUs = 0.0;
+};
@@ -0,0 +1,148 @@
+#include "FrameGen.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace {
+constexpr double kNoHi = HUGE_VAL;
+
+inline double clamp(double v, double lo, double hi = kNoHi){ return std::min(hi, std::max(lo, v)); }
+inline double snap(double v, double lo, double hi){ return std::round(clamp(v, lo, hi)); }
+
+void appendNumber(std::string& out, double v, int decimals){
+    char buf[64];
+    const auto r = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::fixed, decimals);
+    out.append(buf, r.ptr);
+}
+
+// sim_gen.py format_field: integral values print bare, everything else with six decimals
+void appendField(std::string& out, double v){
+    if(std::fabs(v - std::round(v)) < 1e-6){
+        char buf[32];
+        const auto r = std::to_chars(buf, buf + sizeof(buf), static_cast<long long>(std::llround(v)));
+        out.append(buf, r.ptr);
+    } else {
+        appendNumber(out, v, 6);
+    }
+}
+}  // namespace
+
+FrameGen::FrameGen(const GenConfig& c) : cfg(c), rng(c.seed) {
+    groupId = static_cast<std::uint32_t>(-1);
+    startGroup();
+}
+
+double FrameGen::normal(double mu, double sigma){ return mu + sigma * gauss(rng); }
+double FrameGen::uniform(){ return unit(rng); }
+
+void FrameGen::startGroup(){
+    ++groupId;
+    const double u = uniform();
+    groupLabel = (u < cfg.label_probs[0]) ? 0 : ((u < cfg.label_probs[0] + cfg.label_probs[1]) ? 1 : 2);
+    std::uniform_int_distribution<int> count(cfg.group_min, cfg.group_max);
+    groupLeft = count(rng);
+}
+
+void FrameGen::drawBase(Features& x){
+    x[0] = clamp(normal(2.1e5, 5.8e4), 5e4);
+    x[1] = clamp(normal(155.0, 28.0), 5.0);
+    x[2] = clamp(normal(11.0, 3.0), 1.0);
+    x[3] = clamp(normal(21.0, 6.0), 3.0);
+    x[4] = clamp(normal(0.018, 0.012), 0.0, 0.6);
+    x[5] = clamp(normal(1.1, 0.35), 0.05);
+    x[6] = clamp(normal(2.1, 0.6), 0.05);
+    x[7] = normal(0.0, 1.1);
+    x[8] = clamp(normal(0.2, 0.6), 0.0, 8.0);
+    x[9] = clamp(normal(24.0, 10.0), 1.0, 60.0);
+    x[10] = clamp(normal(3.0, 1.2), 1.0, 8.0);
+    x[11] = clamp(normal(2.0, 0.6), 1.0, 5.0);
+    x[12] = clamp(normal(3.0, 2.5), 0.0, 10.0);
+    x[13] = normal(0.0, 1.3);
+    x[14] = clamp(normal(70.0, 35.0), 5.0);
+    x[15] = clamp(normal(0.45, 0.22), 0.0, 1.0);
+    x[16] = 0.0;  // rule_score, derived after guard bits
+    x[17] = 0.0;
+}
+
+void FrameGen::applyLabel(Features& x, int label){
+    if(label == 1){  // cyber-esque
+        x[4] = clamp(x[4] + normal(0.055, 0.03), 0.0, 0.95);
+        x[8] = clamp(x[8] + normal(1.4, 0.9), 0.0, 12.0);
+        x[14] = clamp(x[14] + normal(40.0, 80.0), 10.0, 800.0);
+        x[15] = clamp(x[15] + normal(0.18, 0.15), 0.0, 1.0);
+    } else if(label == 2){  // non-cyber fault
+        x[2] = clamp(x[2] + normal(6.0, 3.0), 1.0, 40.0);
+        x[3] = clamp(x[3] + normal(12.0, 5.0), 5.0, 90.0);
+        x[13] += normal(3.2, 1.8);
+        x[14] = clamp(x[14] + normal(420.0, 240.0), 30.0, 1600.0);
+    } else {  // benign background
+        x[7] += normal(0.0, 0.6);
+        x[14] = clamp(x[14] + normal(-10.0, 50.0), 5.0);
+    }
+    x[0] = clamp(x[0] + normal(0.0, 2.7e4), 2e4, 6e5);
+    x[1] = clamp(x[1] + normal(0.0, 18.0), 0.0, 400.0);
+    x[6] = clamp(x[6] + normal(0.0, 0.45), 0.02, 6.0);
+}
+
+unsigned int FrameGen::guardBits(int label){
+    unsigned int bits = 0;
+    if(label == 1){
+        if(uniform() < 0.65) bits |= 0b010;  // rate guard
+        if(uniform() < 0.40) bits |= 0b001;  // param guard
+        if(uniform() < 0.18) bits |= 0b100;  // replay guard
+        return bits;
+    }
+    if(label == 2){
+        if(uniform() < 0.35) bits |= 0b001;
+        if(uniform() < 0.20) bits |= 0b100;
+        return bits;
+    }
+    return uniform() < 0.06 ? 1U : 0U;  // benign: occasional nuisance hits
+}
+
+int FrameGen::next(Features& x){
+    if(groupLeft <= 0) startGroup();
+    --groupLeft;
+
+    drawBase(x);
+    applyLabel(x, groupLabel);
+    int label = groupLabel;
+    if(uniform() < cfg.label_noise){
+        label = static_cast<int>(rng() % 3);
+    }
+    const unsigned int bits = guardBits(label);
+    x[17] = static_cast<double>(bits);
+    x[16] = std::min(1.0, __builtin_popcount(bits) / 4.0);
+
+    // Snap discrete fields to their integer domains
+    x[8] = snap(x[8], 0.0, 12.0);
+    x[9] = snap(x[9], 1.0, 60.0);
+    x[10] = snap(x[10], 1.0, 12.0);
+    x[11] = snap(x[11], 1.0, 6.0);
+    x[12] = snap(x[12], 0.0, 15.0);
+    return label;
+}
+
+void FrameGen::appendRow(std::string& out, double ts, const Features& x, int label){
+    appendNumber(out, ts, 6);
+    for(std::size_t i=0; i<16; ++i){
+        out.push_back(',');
+        appendField(out, x[i]);
+    }
+    out.push_back(',');
+    appendField(out, x[17]);
+    if(label >= 0){
+        out.push_back(',');
+        out.push_back(static_cast<char>('0' + label));
+    }
+    out.push_back('\n');
+}
+
+std::string FrameGen::header(bool withLabels){
+    std::string h = "ts,bytes_per_s,pkts_per_s,iat_p50_ms,iat_p95_ms,retrans_pct,ttl_var,win_var,flow_delta,"
+                    "fivetuple_changes,opcode,subsystem,mode,param_bucket,seq_gap,resp_delay_ms,ack_flag_rate,"
+                    "guard_violation_bits";
+    if(withLabels) h += ",label";
+    h.push_back('\n');
+    return h;
+}
@@ -0,0 +1,467 @@
+// High-rate feature frame generator and end-to-end latency soak harness.
+//
+// Frames follow tools/sim/generator.py and carry their send time (CLOCK_REALTIME,
+// microseconds) in the ts column. Output goes to a file, to a Unix socket that
+// DetectorRB3 connects to, or to the stdin of a detector command whose stdout
+// is read back to match each output line's ts to its send time.
+#include "FrameGen.hpp"
+#include "LatencyHist.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+volatile std::sig_atomic_t g_shouldStop = 0;
+
+void handleSignal(int) {
+    g_shouldStop = 1;
+}
+
+struct Options {
+    double rate = 1000.0;         // frames per second
+    double duration = 0.0;        // seconds, 0 = until SIGINT
+    long burst = 1;               // frames emitted back-to-back per tick
+    std::string outPath;          // file or "-" for stdout
+    std::string socketPath;       // serve frames on this Unix socket
+    std::string execCmd;          // detector command: frames to stdin, results from stdout
+    double reportSecs = 10.0;
+    std::size_t maxPending = 256 * 1024;  // bytes buffered before frames are dropped
+    double rampStepSecs = 0.0;    // >0 enables ramp mode
+    double rampFactor = 1.25;
+    double maxP99Ms = 50.0;       // ramp stops when interval p99 exceeds this
+    bool withLabels = false;
+    GenConfig gen{};
+};
+
+void printUsage(const char* app) {
+    std::fprintf(stderr,
+                 "Usage: %s [options]\n"
+                 "  -r <fps>    Target frame rate (default: 1000)\n"
+                 "  -d <secs>   Run time, 0 runs until SIGINT (default: 0)\n"
+                 "  -b <n>      Burst size: n frames back-to-back every n/rate seconds (default: 1)\n"
+                 "  -o <path>   Write frames to a file, '-' for stdout\n"
+                 "  -s <path>   Serve frames on a Unix socket (DetectorRB3 -s connects here)\n"
+                 "  -x <cmd>    Run a detector command, e.g. './standalone/detector_main', and measure latency\n"
+                 "  -R <secs>   Report interval (default: 10)\n"
+                 "  -q <bytes>  Pending output bound before frames are dropped (default: 262144)\n"
+                 "  -g <secs>   Ramp mode: raise rate by -f every <secs> until drops or p99 > -m\n"
+                 "  -f <x>      Ramp factor (default: 1.25)\n"
+                 "  -m <ms>     Ramp p99 latency limit (default: 50)\n"
+                 "  -n <p>      Label noise probability (default: 0.05)\n"
+                 "  -S <seed>   Random seed (default: 0)\n"
+                 "  -l          Append ground-truth label column\n"
+                 "  -h          Show this help message\n",
+                 app);
+}
+
+double monoSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double wallSeconds() {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+}
+
+// ----------------------------------------------------------------------
+// Output sink: bounded pending buffer drained with non-blocking writes
+// ----------------------------------------------------------------------
+
+class Sink {
+  public:
+    Sink(int fd, std::size_t maxPending) : fd(fd), maxPending(maxPending) {
+        pending.reserve(maxPending + 512);
+    }
+
+    // Queues a complete row, or refuses it when the consumer is too far behind.
+    bool offer(const std::string& row) {
+        if (pending.size() + row.size() > maxPending) {
+            return false;
+        }
+        pending.append(row);
+        return true;
+    }
+
+    // Writes what the consumer will take now; false once the consumer is gone.
+    bool flush() {
+        std::size_t off = 0;
+        while (off < pending.size()) {
+            const ssize_t n = ::write(fd, pending.data() + off, pending.size() - off);
+            if (n > 0) {
+                off += static_cast<std::size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            pending.erase(0, off);
+            return false;
+        }
+        pending.erase(0, off);
+        return true;
+    }
+
+    bool empty() const { return pending.empty(); }
+
+  private:
+    int fd;
+    std::size_t maxPending;
+    std::string pending;
+};
+
+void setNonBlocking(int fd) {
+    const int flags = ::fcntl(fd, F_GETFL, 0);
+    ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+int serveSocket(const std::string& path) {
+    const int lfd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (lfd < 0) {
+        return -1;
+    }
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+    ::unlink(path.c_str());
+    if (::bind(lfd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(lfd, 1) != 0) {
+        ::close(lfd);
+        return -1;
+    }
+    std::fprintf(stderr, "[loadgen] waiting for detector on %s\n", path.c_str());
+    int fd = -1;
+    while (fd < 0 && !g_shouldStop) {
+        fd = ::accept(lfd, nullptr, nullptr);
+        if (fd < 0 && errno != EINTR) {
+            break;
+        }
+    }
+    ::close(lfd);
+    return fd;
+}
+
+// ----------------------------------------------------------------------
+// Detector child process and result collector
+// ----------------------------------------------------------------------
+
+struct Child {
+    pid_t pid{-1};
+    int stdinFd{-1};
+    int stdoutFd{-1};
+};
+
+bool spawnDetector(const std::string& cmd, Child& child) {
+    int in[2];
+    int out[2];
+    if (::pipe(in) != 0) {
+        return false;
+    }
+    if (::pipe(out) != 0) {
+        ::close(in[0]);
+        ::close(in[1]);
+        return false;
+    }
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        ::dup2(in[0], STDIN_FILENO);
+        ::dup2(out[1], STDOUT_FILENO);
+        ::close(in[0]);
+        ::close(in[1]);
+        ::close(out[0]);
+        ::close(out[1]);
+        ::execl("/bin/sh", "sh", "-c", cmd.c_str(), static_cast<char*>(nullptr));
+        ::_exit(127);
+    }
+    ::close(in[0]);
+    ::close(out[1]);
+    child.pid = pid;
+    child.stdinFd = in[1];
+    child.stdoutFd = out[0];
+    return true;
+}
+
+struct Results {
+    std::mutex mu;
+    LatencyHist interval;
+    LatencyHist step;
+    LatencyHist total;
+    std::uint64_t received{0};
+};
+
+// Reads detector output lines; the first field of each is the ts we sent.
+void collectResults(int fd, Results& res) {
+    std::string carry;
+    char buf[65536];
+    for (;;) {
+        const ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        const double now = wallSeconds();
+        carry.append(buf, static_cast<std::size_t>(n));
+        std::size_t start = 0;
+        std::lock_guard<std::mutex> lock(res.mu);
+        for (;;) {
+            const auto nl = carry.find('\n', start);
+            if (nl == std::string::npos) {
+                break;
+            }
+            const char* line = carry.c_str() + start;
+            char* end = nullptr;
+            const double ts = std::strtod(line, &end);
+            if (end != line) {
+                const double us = (now - ts) * 1e6;
+                res.interval.record(us);
+                res.step.record(us);
+                res.total.record(us);
+                ++res.received;
+            }
+            start = nl + 1;
+        }
+        carry.erase(0, start);
+    }
+}
+
+// ----------------------------------------------------------------------
+// Reporting
+// ----------------------------------------------------------------------
+
+struct Counters {
+    std::uint64_t sent{0};
+    std::uint64_t dropped{0};
+};
+
+void printLatency(const LatencyHist& h) {
+    if (h.count() == 0) {
+        return;
+    }
+    std::fprintf(stderr, " lat p50 %.3fms p99 %.3fms p999 %.3fms max %.3fms",
+                 h.percentile(0.50) / 1e3, h.percentile(0.99) / 1e3, h.percentile(0.999) / 1e3, h.max() / 1e3);
+}
+
+void report(double elapsed, double rate, const Counters& c, const Counters& last, double span, Results* res) {
+    std::fprintf(stderr, "[%8.1fs] target %.0f/s sent %.0f/s total %llu drop %llu",
+                 elapsed, rate, static_cast<double>(c.sent - last.sent) / span,
+                 static_cast<unsigned long long>(c.sent), static_cast<unsigned long long>(c.dropped));
+    if (res) {
+        std::lock_guard<std::mutex> lock(res->mu);
+        std::fprintf(stderr, " recv %llu", static_cast<unsigned long long>(res->received));
+        printLatency(res->interval);
+        res->interval.reset();
+    }
+    std::fprintf(stderr, "\n");
+}
+
+bool parseOptions(int argc, char* argv[], Options& opt) {
+    int c = 0;
+    while ((c = ::getopt(argc, argv, "hr:d:b:o:s:x:R:q:g:f:m:n:S:l")) != -1) {
+        switch (c) {
+            case 'r': opt.rate = std::strtod(optarg, nullptr); break;
+            case 'd': opt.duration = std::strtod(optarg, nullptr); break;
+            case 'b': opt.burst = std::max(1L, std::strtol(optarg, nullptr, 10)); break;
+            case 'o': opt.outPath = optarg; break;
+            case 's': opt.socketPath = optarg; break;
+            case 'x': opt.execCmd = optarg; break;
+            case 'R': opt.reportSecs = std::strtod(optarg, nullptr); break;
+            case 'q': opt.maxPending = static_cast<std::size_t>(std::strtoull(optarg, nullptr, 10)); break;
+            case 'g': opt.rampStepSecs = std::strtod(optarg, nullptr); break;
+            case 'f': opt.rampFactor = std::strtod(optarg, nullptr); break;
+            case 'm': opt.maxP99Ms = std::strtod(optarg, nullptr); break;
+            case 'n': opt.gen.label_noise = std::strtod(optarg, nullptr); break;
+            case 'S': opt.gen.seed = std::strtoull(optarg, nullptr, 10); break;
+            case 'l': opt.withLabels = true; break;
+            case 'h':
+            default:
+                printUsage(argv[0]);
+                return false;
+        }
+    }
+    const int sinks = !opt.outPath.empty() + !opt.socketPath.empty() + !opt.execCmd.empty();
+    if (sinks != 1 || opt.rate <= 0.0 || opt.reportSecs <= 0.0) {
+        printUsage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        return 1;
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int fd = -1;
+    Child child;
+    if (!opt.execCmd.empty()) {
+        if (!spawnDetector(opt.execCmd, child)) {
+            std::perror("spawn");
+            return 1;
+        }
+        fd = child.stdinFd;
+    } else if (!opt.socketPath.empty()) {
+        fd = serveSocket(opt.socketPath);
+    } else if (opt.outPath == "-") {
+        fd = STDOUT_FILENO;
+    } else {
+        fd = ::open(opt.outPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (fd < 0) {
+        std::perror("open sink");
+        return 1;
+    }
+    setNonBlocking(fd);
+
+    Results results;
+    Results* res = opt.execCmd.empty() ? nullptr : &results;
+    std::thread collector;
+    if (res) {
+        collector = std::thread(collectResults, child.stdoutFd, std::ref(results));
+    }
+
+    FrameGen gen(opt.gen);
+    FrameGen::Features x{};
+    Sink sink(fd, opt.maxPending);
+    std::string row;
+    row.reserve(512);
+    sink.offer(FrameGen::header(opt.withLabels));
+
+    // Open loop: frame i is due at i/rate from the start of the current rate step,
+    // released in groups of `burst`. Responses never hold back the schedule.
+    constexpr std::uint64_t kMaxBatch = 4096;
+    double rate = opt.rate;
+    double maxSustained = 0.0;
+    const double t0 = monoSeconds();
+    double stepStart = t0;
+    std::uint64_t stepBase = 0;
+    Counters cnt;
+    Counters stepCnt;
+    Counters lastReport;
+    double lastReportAt = t0;
+    bool consumerGone = false;
+
+    while (!g_shouldStop && !consumerGone) {
+        const double now = monoSeconds();
+        if (opt.duration > 0.0 && now - t0 >= opt.duration) {
+            break;
+        }
+
+        const std::uint64_t ticks = static_cast<std::uint64_t>((now - stepStart) * rate / opt.burst);
+        const std::uint64_t due = stepBase + (ticks + 1) * static_cast<std::uint64_t>(opt.burst);
+        const std::uint64_t generated = cnt.sent + cnt.dropped;
+        std::uint64_t todo = due > generated ? std::min(due - generated, kMaxBatch) : 0;
+        for (; todo > 0; --todo) {
+            const int label = gen.next(x);
+            row.clear();
+            FrameGen::appendRow(row, wallSeconds(), x, opt.withLabels ? label : -1);
+            if (sink.offer(row)) {
+                ++cnt.sent;
+            } else {
+                ++cnt.dropped;
+            }
+        }
+        consumerGone = !sink.flush();
+
+        if (now - lastReportAt >= opt.reportSecs) {
+            report(now - t0, rate, cnt, lastReport, now - lastReportAt, res);
+            lastReport = cnt;
+            lastReportAt = now;
+        }
+
+        if (opt.rampStepSecs > 0.0 && now - stepStart >= opt.rampStepSecs) {
+            double p99Ms = 0.0;
+            if (res) {
+                std::lock_guard<std::mutex> lock(res->mu);
+                p99Ms = res->step.percentile(0.99) / 1e3;
+                res->step.reset();
+            }
+            const bool clean = cnt.dropped == stepCnt.dropped && p99Ms <= opt.maxP99Ms;
+            std::fprintf(stderr, "[loadgen] step %.0f/s: %s (drops %llu, p99 %.3fms)\n", rate, clean ? "sustained" : "saturated",
+                         static_cast<unsigned long long>(cnt.dropped - stepCnt.dropped), p99Ms);
+            if (!clean) {
+                break;
+            }
+            maxSustained = rate;
+            rate *= opt.rampFactor;
+            stepStart = now;
+            stepBase = cnt.sent + cnt.dropped;
+            stepCnt = cnt;
+            // ticks belongs to the old step; reschedule from the new origin rather than sleep on it
+            continue;
+        }
+
+        // Sleep until the next burst is due, or briefly if output is still draining
+        const double nextDue = stepStart + (static_cast<double>(ticks + 1) * opt.burst) / rate;
+        double wait = nextDue - monoSeconds();
+        if (!sink.empty()) {
+            wait = std::min(wait, 0.0005);
+        }
+        if (wait > 0.0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(std::min(wait, 0.1)));
+        }
+    }
+
+    // Drain what is already queued, then let the detector see EOF
+    const double drainUntil = monoSeconds() + 2.0;
+    while (!sink.empty() && monoSeconds() < drainUntil && sink.flush()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (fd != STDOUT_FILENO) {
+        ::close(fd);
+    }
+    if (res) {
+        collector.join();
+        ::close(child.stdoutFd);
+        int status = 0;
+        ::waitpid(child.pid, &status, 0);
+    }
+
+    const double elapsed = monoSeconds() - t0;
+    std::fprintf(stderr, "[loadgen] done: %.1fs sent %llu dropped %llu avg %.0f/s",
+                 elapsed, static_cast<unsigned long long>(cnt.sent), static_cast<unsigned long long>(cnt.dropped),
+                 static_cast<double>(cnt.sent) / elapsed);
+    if (res) {
+        std::fprintf(stderr, " recv %llu lost %llu", static_cast<unsigned long long>(results.received),
+                     static_cast<unsigned long long>(cnt.sent > results.received ? cnt.sent - results.received : 0));
+        printLatency(results.total);
+    }
+    std::fprintf(stderr, "\n");
+    if (opt.rampStepSecs > 0.0) {
+        std::fprintf(stderr, "[loadgen] max sustained rate without drops: %.0f/s\n", maxSustained);
+    }
+    return 0;
+}
@@ -9,9 +9,14 @@ uv pip install -q numpy scikit-learn
 cd "$REPO_DIR/tools/train"
 python3 train_forest.py | tee "$REPO_DIR/train_report.txt"
 
-# Copy outputs into Detector config
-cp -f exported_forest.model "$REPO_DIR/deployments/DetectorRB3/config/forest.model"
-cp -f exported_calibrator.cfg "$REPO_DIR/deployments/DetectorRB3/config/calibrator.cfg"
+# Copy outputs into Detector config (or its shadow slot with --shadow)
+CONF_REL="deployments/DetectorRB3/config"
+if [ "${1:-}" = "--shadow" ]; then
+  CONF_REL="$CONF_REL/shadow"
+fi
+mkdir -p "$REPO_DIR/$CONF_REL"
+cp -f exported_forest.model "$REPO_DIR/$CONF_REL/forest.model"
+cp -f exported_calibrator.cfg "$REPO_DIR/$CONF_REL/calibrator.cfg"
 
-echo "Updated model + calibrator in deployments/DetectorRB3/config/"
+echo "Updated model + calibrator in $CONF_REL/"
 
@@ -33,13 +33,11 @@ def export_forest(model: RandomForestClassifier, path: Path) -> None:
                 thr = float(t.threshold[i])
                 l = int(t.children_left[i])
                 r = int(t.children_right[i])
-                leaf = l == -1 and r == -1
-                if leaf:
-                    counts = t.value[i][0]
-                    total = counts.sum() + 1e-9
-                    p = counts / total
-                else:
-                    p = np.array([0.34, 0.33, 0.33])
+                # Internal nodes carry their training distribution too; the Detector's
+                # decision-path attribution measures each split as child minus parent.
+                counts = t.value[i][0]
+                total = counts.sum() + 1e-9
+                p = counts / total
                 f.write(
                     f"{i} {f_idx} {thr:.6f} {l} {r} {p[0]:.6f} {p[1]:.6f} {p[2]:.6f}\n"
                 )
@@ -72,8 +70,11 @@ def _rule_score_from_bits(bits: np.ndarray) -> np.ndarray:
     return np.clip(scores / 4.0, 0.0, 1.0)
 
 
-def _novelty_from_probs(probs: np.ndarray, threshold: float = 0.5) -> np.ndarray:
-    return (probs.max(axis=1) < threshold).astype(np.float32)
+def _novelty_from_probs(probs: np.ndarray, threshold: float = 0.5, width: float = 0.1) -> np.ndarray:
+    # Matches NoveltyScorer::forestTerm: soft ramp around the old max(p) < threshold flag.
+    # The streaming half of the on-board novelty score needs history, so it is not modelled here.
+    ramp = (threshold + width / 2 - probs.max(axis=1)) / width
+    return np.clip(ramp, 0.0, 1.0).astype(np.float32)
 
 
 def main() -> None:
@@ -151,6 +152,10 @@ def main() -> None:
         "bias": bias,
     }
     with args.calibrator_path.open("w") as cfg_out:
+        cfg_out.write(
+            "# w_novelty is fitted by train_forest.py on the forest ramp novelty only; the Detector feeds\n"
+            "# max(forest ramp, streaming NoveltyScorer), so the weight is not calibrated for the streaming term.\n"
+        )
         for key, value in calibrator_config.items():
             cfg_out.write(f"{key} {value}\n")
 